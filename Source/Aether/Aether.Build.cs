@@ -32,6 +32,7 @@ public class Aether : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"AetherMath",
 				"Core",
 				"Engine",
 				//"Renderer",
@@ -9,6 +9,8 @@
 #include "Styling/SlateStyleMacros.h"
 #include "Styling/SlateStyleRegistry.h"
 
+DEFINE_LOG_CATEGORY(LogAether);
+
 #define LOCTEXT_NAMESPACE "FAetherModule"
 
 #define RootToContentDir StyleSet->RootToContentDir
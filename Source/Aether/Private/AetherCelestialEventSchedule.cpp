@@ -0,0 +1,232 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherCelestialEventSchedule.h"
+
+#include "AetherWorldMath.inl"
+
+namespace AetherCelestialEventSchedule
+{
+	/**
+	 * Degree. Sun elevation of astronomical, nautical, civil twilight and sunrise/sunset (refraction and disk radius).
+	 */
+	static const float SunEventElevation[4] = { -18.0f, -12.0f, -6.0f, -0.833f };
+	
+	/**
+	 * Degree. Moon elevation of moonrise/moonset, parallax minus refraction and disk radius.
+	 */
+	static const float MoonEventElevation = 0.125f;
+	
+	/**
+	 * The moon runs several cycles per simulated day, sample dense enough to catch a short arc above the horizon.
+	 */
+	static const int32 MoonSampleCount = 96;
+	static const int32 MoonBisectionCount = 12;
+	
+	/**
+	 * Degree. Coordinate change tolerated before the day is solved again.
+	 */
+	static const float CoordinateTolerance = 0.05f;
+}
+
+FAetherCelestialEventSchedule::FAetherCelestialEventSchedule()
+{
+	Invalidate();
+}
+
+void FAetherCelestialEventSchedule::Invalidate()
+{
+	Events.Reset();
+	CachedDay = INDEX_NONE;
+	CachedDaysPerYear = 0;
+	CachedLatitude = 0.0f;
+	CachedLongitude = 0.0f;
+	NextEventIndex = 0;
+	LastProgressOfDay = 0.0f;
+}
+
+void FAetherCelestialEventSchedule::Update(float ProgressOfYear, int32 DaysPerYear, float Latitude, float Longitude)
+{
+	if (DaysPerYear <= 0)
+	{
+		return;
+	}
+	
+	const float DayProgress = ProgressOfYear * DaysPerYear;
+	const int32 Day = FMath::Clamp(FMath::FloorToInt(DayProgress), 0, DaysPerYear - 1);
+	const float ProgressOfDay = FMath::Clamp(DayProgress - Day, 0.0f, 1.0f);
+	
+	if (CachedDay == INDEX_NONE || CachedDaysPerYear != DaysPerYear)
+	{
+		BuildDay(Day, DaysPerYear, Latitude, Longitude);
+		LastProgressOfDay = ProgressOfDay;
+		NextEventIndex = FindFirstEventAfter(LastProgressOfDay);
+		return;
+	}
+	
+	if (CachedDay != Day)
+	{
+		const bool bNextDay = Day == (CachedDay + 1) % DaysPerYear;
+		if (bNextDay)
+		{
+			// Finish the day left behind.
+			BroadcastUntil(1.0f);
+		}
+		BuildDay(Day, DaysPerYear, Latitude, Longitude);
+		// Time jump, do not replay the events skipped.
+		LastProgressOfDay = bNextDay ? -1.0f : ProgressOfDay;
+		NextEventIndex = FindFirstEventAfter(LastProgressOfDay);
+	}
+	else if (FMath::Abs(Latitude - CachedLatitude) > AetherCelestialEventSchedule::CoordinateTolerance
+		|| FMath::Abs(FMath::UnwindDegrees(Longitude - CachedLongitude)) > AetherCelestialEventSchedule::CoordinateTolerance)
+	{
+		BuildDay(Day, DaysPerYear, Latitude, Longitude);
+		NextEventIndex = FindFirstEventAfter(LastProgressOfDay);
+	}
+	else if (ProgressOfDay < LastProgressOfDay)
+	{
+		LastProgressOfDay = ProgressOfDay;
+		NextEventIndex = FindFirstEventAfter(LastProgressOfDay);
+	}
+	
+	BroadcastUntil(ProgressOfDay);
+	LastProgressOfDay = ProgressOfDay;
+}
+
+FDelegateHandle FAetherCelestialEventSchedule::Subscribe(EAetherCelestialEvent Event, FAetherCelestialEventSignature::FDelegate&& Delegate)
+{
+	check(Event < EAetherCelestialEvent::MAX);
+	return Delegates[(int32)Event].Add(MoveTemp(Delegate));
+}
+
+void FAetherCelestialEventSchedule::Unsubscribe(EAetherCelestialEvent Event, FDelegateHandle Handle)
+{
+	check(Event < EAetherCelestialEvent::MAX);
+	Delegates[(int32)Event].Remove(Handle);
+}
+
+bool FAetherCelestialEventSchedule::GetNextEventTime(EAetherCelestialEvent Event, float& OutProgressOfYear) const
+{
+	for (int32 Index = NextEventIndex; Index < Events.Num(); Index++)
+	{
+		if (Events[Index].Event == Event)
+		{
+			OutProgressOfYear = (CachedDay + Events[Index].ProgressOfDay) / CachedDaysPerYear;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FAetherCelestialEventSchedule::BuildDay(int32 Day, int32 DaysPerYear, float Latitude, float Longitude)
+{
+	Events.Reset();
+	CachedDay = Day;
+	CachedDaysPerYear = DaysPerYear;
+	CachedLatitude = Latitude;
+	CachedLongitude = Longitude;
+	
+	// Sun: analytic, the hour angle of each elevation is solved with the declination at the mid of the day first,
+	// then once more with the declination at the solved time since the simulated day spans several earth days.
+	const float EarthDaysPerDay = (float)DAYS_PER_YEAR_EARTH / DaysPerYear;
+	for (int32 Level = 0; Level < 4; Level++)
+	{
+		for (int32 Side = 0; Side < 2; Side++)
+		{
+			float ProgressOfDay = 0.5f;
+			bool bHasSolution = true;
+			for (int32 Iteration = 0; Iteration < 2; Iteration++)
+			{
+				const float SolarDeclination = CalculateSolarDeclination((Day + ProgressOfDay) * EarthDaysPerDay);
+				float HourAngle = 0.0f;
+				if (CalculateSunHourAngleAtElevation(Latitude, SolarDeclination, AetherCelestialEventSchedule::SunEventElevation[Level], HourAngle) != 0)
+				{
+					bHasSolution = false;
+					break;
+				}
+				ProgressOfDay = ConvertSunHourAngleToTimeStampOfEarthDay(Side == 0 ? -HourAngle : HourAngle, Longitude) / SECONDS_PER_DAY_EARTH;
+			}
+			if (bHasSolution)
+			{
+				const EAetherCelestialEvent Event = (EAetherCelestialEvent)(Side == 0 ? Level : 7 - Level);
+				Events.Add({ Event, ProgressOfDay });
+			}
+		}
+	}
+	
+	// Moon: sample the elevation over the day in one batch, then bisect every horizon crossing.
+	{
+		using namespace AetherCelestialEventSchedule;
+		
+		const int32 Num = MoonSampleCount + 1;
+		float Latitudes[Num];
+		float Longitudes[Num];
+		float TimeStampOfEarthDay[Num];
+		float TimeStampOfEarthYear[Num];
+		float Elevation[Num];
+		float Azimuth[Num];
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const float ProgressOfDay = (float)Index / MoonSampleCount;
+			Latitudes[Index] = Latitude;
+			Longitudes[Index] = Longitude;
+			TimeStampOfEarthDay[Index] = ProgressOfDay * SECONDS_PER_DAY_EARTH;
+			TimeStampOfEarthYear[Index] = (Day + ProgressOfDay) / DaysPerYear * SECONDS_PER_YEAR_EARTH;
+		}
+		CalculateMoonPositionBatch(Latitudes, Longitudes, TimeStampOfEarthDay, TimeStampOfEarthYear, Elevation, Azimuth, Num);
+		
+		for (int32 Index = 1; Index < Num; Index++)
+		{
+			const bool bAbovePrev = Elevation[Index - 1] > MoonEventElevation;
+			const bool bAbove = Elevation[Index] > MoonEventElevation;
+			if (bAbovePrev == bAbove)
+			{
+				continue;
+			}
+			
+			float Low = (float)(Index - 1) / MoonSampleCount;
+			float High = (float)Index / MoonSampleCount;
+			for (int32 Iteration = 0; Iteration < MoonBisectionCount; Iteration++)
+			{
+				const float Mid = (Low + High) * 0.5f;
+				float MidElevation, MidAzimuth;
+				CalculateMoonPosition(Latitude, Longitude, Mid * SECONDS_PER_DAY_EARTH, (Day + Mid) / DaysPerYear * SECONDS_PER_YEAR_EARTH, MidElevation, MidAzimuth);
+				if ((MidElevation > MoonEventElevation) == bAbovePrev)
+				{
+					Low = Mid;
+				}
+				else
+				{
+					High = Mid;
+				}
+			}
+			Events.Add({ bAbove ? EAetherCelestialEvent::Moonrise : EAetherCelestialEvent::Moonset, (Low + High) * 0.5f });
+		}
+	}
+	
+	Events.Sort([](const FAetherCelestialEventTime& A, const FAetherCelestialEventTime& B)
+	{
+		return A.ProgressOfDay < B.ProgressOfDay;
+	});
+}
+
+int32 FAetherCelestialEventSchedule::FindFirstEventAfter(float ProgressOfDay) const
+{
+	int32 Index = 0;
+	while (Index < Events.Num() && Events[Index].ProgressOfDay <= ProgressOfDay)
+	{
+		Index++;
+	}
+	return Index;
+}
+
+void FAetherCelestialEventSchedule::BroadcastUntil(float ProgressOfDay)
+{
+	while (NextEventIndex < Events.Num() && Events[NextEventIndex].ProgressOfDay <= ProgressOfDay)
+	{
+		const FAetherCelestialEventTime EventTime = Events[NextEventIndex++];
+		Delegates[(int32)EventTime.Event].Broadcast(EventTime.Event, (CachedDay + EventTime.ProgressOfDay) / CachedDaysPerYear);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherClimatologyAsset.h"
+
+#include "Aether.h"
+#include "AetherWeatherEvent.h"
+
+FAetherClimateSample::FAetherClimateSample()
+{
+	AirTemperature = 0.0f;
+	Precipitation = 0.0f;
+}
+
+UAetherClimatologyAsset::UAetherClimatologyAsset()
+{
+	Origin = FVector2D::ZeroVector;
+	CellSize = 100000.0f;
+	GridSize = FIntPoint::ZeroValue;
+	CellValues = nullptr;
+}
+
+void UAetherClimatologyAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+	
+	// Saving locks the payload itself.
+	const bool bRemap = Ar.IsSaving() && CellValues;
+	if (bRemap)
+	{
+		UnmapCellData();
+	}
+	CellData.Serialize(Ar, this);
+	if (bRemap)
+	{
+		MapCellData();
+	}
+}
+
+void UAetherClimatologyAsset::PostLoad()
+{
+	Super::PostLoad();
+	
+	MapCellData();
+}
+
+void UAetherClimatologyAsset::BeginDestroy()
+{
+	UnmapCellData();
+	CellData.RemoveBulkData();
+	
+	Super::BeginDestroy();
+}
+
+void UAetherClimatologyAsset::MapCellData()
+{
+	UnmapCellData();
+	if (GetNumValues() == 0)
+	{
+		return;
+	}
+	if (CellData.GetBulkDataSize() != GetNumValues() * (int64)sizeof(FFloat16))
+	{
+		UE_LOG(LogAether, Warning, TEXT("Climatology %s does not match its grid, rebuild it."), *GetName());
+		return;
+	}
+	// Mapped instead of copied when the payload was cooked memory mapped. The read lock is held until UnmapCellData.
+	CellData.ForceBulkDataResident();
+	CellValues = static_cast<const FFloat16*>(CellData.LockReadOnly());
+}
+
+void UAetherClimatologyAsset::UnmapCellData()
+{
+	if (CellValues)
+	{
+		CellValues = nullptr;
+		CellData.Unlock();
+	}
+}
+
+int64 UAetherClimatologyAsset::GetNumValues() const
+{
+	return (int64)FMath::Max(GridSize.X, 0) * FMath::Max(GridSize.Y, 0) * 12 * GetNumChannels();
+}
+
+bool UAetherClimatologyAsset::Sample(const FVector& Location, float ProgressOfYear, FAetherClimateSample& OutSample) const
+{
+	if (!CellValues)
+	{
+		return false;
+	}
+	
+	const double GridX = (Location.X - Origin.X) / CellSize;
+	const double GridY = (Location.Y - Origin.Y) / CellSize;
+	if (GridX < 0.0 || GridY < 0.0 || GridX >= GridSize.X || GridY >= GridSize.Y)
+	{
+		return false;
+	}
+	
+	// Cell centered, clamped to the outer half cells.
+	const double CenterX = FMath::Clamp(GridX - 0.5, 0.0, (double)(GridSize.X - 1));
+	const double CenterY = FMath::Clamp(GridY - 0.5, 0.0, (double)(GridSize.Y - 1));
+	const int32 X0 = FMath::Min((int32)CenterX, GridSize.X - 1);
+	const int32 Y0 = FMath::Min((int32)CenterY, GridSize.Y - 1);
+	const int32 X1 = FMath::Min(X0 + 1, GridSize.X - 1);
+	const int32 Y1 = FMath::Min(Y0 + 1, GridSize.Y - 1);
+	const float AlphaX = (float)(CenterX - X0);
+	const float AlphaY = (float)(CenterY - Y0);
+	
+	// Normals are mid month, wrap from December to January.
+	const float MonthPosition = FMath::Fmod(FMath::Frac(ProgressOfYear) * 12.0f + 11.5f, 12.0f);
+	const int32 Month0 = FMath::Min((int32)MonthPosition, 11);
+	const int32 Month1 = (Month0 + 1) % 12;
+	const float AlphaMonth = MonthPosition - Month0;
+	
+	const int32 NumChannels = GetNumChannels();
+	const int64 MonthStride = NumChannels;
+	const int64 CellStride = 12 * MonthStride;
+	const FFloat16* Corners[4] = {
+		CellValues + ((int64)Y0 * GridSize.X + X0) * CellStride,
+		CellValues + ((int64)Y0 * GridSize.X + X1) * CellStride,
+		CellValues + ((int64)Y1 * GridSize.X + X0) * CellStride,
+		CellValues + ((int64)Y1 * GridSize.X + X1) * CellStride,
+	};
+	const float CornerWeights[4] = {
+		(1.0f - AlphaX) * (1.0f - AlphaY),
+		AlphaX * (1.0f - AlphaY),
+		(1.0f - AlphaX) * AlphaY,
+		AlphaX * AlphaY,
+	};
+	
+	auto SampleChannel = [&](int32 Channel)
+	{
+		float Value = 0.0f;
+		for (int32 Corner = 0; Corner < 4; Corner++)
+		{
+			const float Value0 = Corners[Corner][Month0 * MonthStride + Channel].GetFloat();
+			const float Value1 = Corners[Corner][Month1 * MonthStride + Channel].GetFloat();
+			Value += FMath::Lerp(Value0, Value1, AlphaMonth) * CornerWeights[Corner];
+		}
+		return Value;
+	};
+	
+	OutSample.AirTemperature = SampleChannel(0);
+	OutSample.Precipitation = FMath::Max(SampleChannel(1), 0.0f);
+	OutSample.EventProbabilities.SetNumUninitialized(Events.Num(), EAllowShrinking::No);
+	for (int32 EventIndex = 0; EventIndex < Events.Num(); EventIndex++)
+	{
+		OutSample.EventProbabilities[EventIndex] = FMath::Clamp(SampleChannel(2 + EventIndex), 0.0f, 1.0f);
+	}
+	return true;
+}
+
+#if WITH_EDITOR
+void UAetherClimatologyAsset::Build(FVector2D InOrigin, float InCellSize, FIntPoint InGridSize, const TArray<UAetherWeatherEvent*>& InEvents, const TArray<float>& Values)
+{
+	const int64 NumValues = (int64)FMath::Max(InGridSize.X, 0) * FMath::Max(InGridSize.Y, 0) * 12 * (2 + InEvents.Num());
+	if (InCellSize <= 0.0f || Values.Num() != NumValues)
+	{
+		UE_LOG(LogAether, Error, TEXT("Climatology %s expects %lld values, got %d."), *GetName(), NumValues, Values.Num());
+		return;
+	}
+	
+	Modify();
+	Origin = InOrigin;
+	CellSize = InCellSize;
+	GridSize = InGridSize;
+	Events.Reset();
+	Events.Append(InEvents);
+	
+	UnmapCellData();
+	CellData.RemoveBulkData();
+	CellData.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload | BULKDATA_MemoryMappedPayload);
+	CellData.Lock(LOCK_READ_WRITE);
+	FFloat16* Data = static_cast<FFloat16*>(CellData.Realloc(NumValues * sizeof(FFloat16)));
+	for (int64 Index = 0; Index < NumValues; Index++)
+	{
+		Data[Index] = FFloat16(Values[Index]);
+	}
+	CellData.Unlock();
+	
+	MapCellData();
+}
+#endif
\ No newline at end of file
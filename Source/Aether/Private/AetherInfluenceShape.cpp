@@ -0,0 +1,170 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherInfluenceShape.h"
+
+#include "Algo/Sort.h"
+
+FAetherInfluenceShape::FAetherInfluenceShape()
+{
+	Type = EAetherInfluenceShape::Sphere;
+	Transform = FTransform::Identity;
+	Extent = FVector::ZeroVector;
+	Radius = 0.0f;
+	Bounds = FBox(ForceInit);
+}
+
+void FAetherInfluenceShape::SetSphere(const FVector& InCenter, float InRadius)
+{
+	Type = EAetherInfluenceShape::Sphere;
+	Transform = FTransform(InCenter);
+	Radius = FMath::Max(InRadius, 0.0f);
+	ConvexHull.Reset();
+	Polyline.Reset();
+	Bounds = FBox(InCenter - FVector(Radius), InCenter + FVector(Radius));
+}
+
+void FAetherInfluenceShape::SetBox(const FTransform& InTransform, const FVector& InExtent)
+{
+	Type = EAetherInfluenceShape::Box;
+	Transform = FTransform(InTransform.GetRotation(), InTransform.GetTranslation());
+	Extent = InExtent.ComponentMax(FVector::ZeroVector);
+	ConvexHull.Reset();
+	Polyline.Reset();
+	Bounds = FBox(-Extent, Extent).TransformBy(Transform);
+}
+
+void FAetherInfluenceShape::SetConvex(const FTransform& InTransform, TConstArrayView<FVector2D> InPoints, float InHalfHeight)
+{
+	Type = EAetherInfluenceShape::Convex;
+	Transform = FTransform(InTransform.GetRotation(), InTransform.GetTranslation());
+	Extent = FVector(0.0f, 0.0f, FMath::Max(InHalfHeight, 0.0f));
+	Polyline.Reset();
+	ComputeConvexHull(InPoints, ConvexHull);
+	
+	FBox LocalBounds(ForceInit);
+	for (const FVector2D& Point : ConvexHull)
+	{
+		LocalBounds += FVector(Point.X, Point.Y, -Extent.Z);
+		LocalBounds += FVector(Point.X, Point.Y, Extent.Z);
+	}
+	Bounds = LocalBounds.IsValid ? LocalBounds.TransformBy(Transform) : FBox(ForceInit);
+}
+
+void FAetherInfluenceShape::SetCorridor(TConstArrayView<FVector> InPolyline, float InRadius)
+{
+	Type = EAetherInfluenceShape::Spline;
+	Transform = FTransform::Identity;
+	Radius = FMath::Max(InRadius, 0.0f);
+	ConvexHull.Reset();
+	Polyline = InPolyline;
+	
+	Bounds = FBox(ForceInit);
+	for (const FVector& Point : Polyline)
+	{
+		Bounds += Point;
+	}
+	Bounds = Bounds.IsValid ? Bounds.ExpandBy(Radius) : Bounds;
+}
+
+double FAetherInfluenceShape::GetSignedDistance(const FVector& Point) const
+{
+	switch (Type)
+	{
+	case EAetherInfluenceShape::Sphere:
+		return FVector::Distance(Point, Transform.GetTranslation()) - Radius;
+	case EAetherInfluenceShape::Box:
+		{
+			const FVector Local = Transform.InverseTransformPositionNoScale(Point);
+			const FVector Q = Local.GetAbs() - Extent;
+			return Q.ComponentMax(FVector::ZeroVector).Size() + FMath::Min(Q.GetMax(), 0.0);
+		}
+	case EAetherInfluenceShape::Convex:
+		{
+			if (ConvexHull.Num() < 3)
+			{
+				return MAX_dbl;
+			}
+			const FVector Local = Transform.InverseTransformPositionNoScale(Point);
+			const FVector2D Local2D(Local.X, Local.Y);
+			
+			// Inside the footprint the largest edge plane distance is exact, outside the nearest edge is.
+			double PlaneDistance = -MAX_dbl;
+			double EdgeDistanceSquared = MAX_dbl;
+			for (int32 Index = 0; Index < ConvexHull.Num(); Index++)
+			{
+				const FVector2D& A = ConvexHull[Index];
+				const FVector2D& B = ConvexHull[(Index + 1) % ConvexHull.Num()];
+				const FVector2D Edge = B - A;
+				const FVector2D Normal = FVector2D(Edge.Y, -Edge.X).GetSafeNormal();
+				PlaneDistance = FMath::Max(PlaneDistance, FVector2D::DotProduct(Local2D - A, Normal));
+				
+				const double T = FMath::Clamp(FVector2D::DotProduct(Local2D - A, Edge) / FMath::Max(Edge.SizeSquared(), UE_SMALL_NUMBER), 0.0, 1.0);
+				EdgeDistanceSquared = FMath::Min(EdgeDistanceSquared, FVector2D::DistSquared(Local2D, A + Edge * T));
+			}
+			const double FootprintDistance = PlaneDistance <= 0.0 ? PlaneDistance : FMath::Sqrt(EdgeDistanceSquared);
+			
+			// Extrusion along local Z.
+			const FVector2D W(FootprintDistance, FMath::Abs(Local.Z) - Extent.Z);
+			return FMath::Min(FMath::Max(W.X, W.Y), 0.0) + FVector2D(FMath::Max(W.X, 0.0), FMath::Max(W.Y, 0.0)).Size();
+		}
+	case EAetherInfluenceShape::Spline:
+		{
+			if (Polyline.Num() == 0)
+			{
+				return MAX_dbl;
+			}
+			double DistanceSquared = FVector::DistSquared(Point, Polyline[0]);
+			for (int32 Index = 1; Index < Polyline.Num(); Index++)
+			{
+				DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Point, FMath::ClosestPointOnSegment(Point, Polyline[Index - 1], Polyline[Index])));
+			}
+			return FMath::Sqrt(DistanceSquared) - Radius;
+		}
+	default:
+		return MAX_dbl;
+	}
+}
+
+void FAetherInfluenceShape::ComputeConvexHull(TConstArrayView<FVector2D> InPoints, TArray<FVector2D>& OutHull)
+{
+	// Monotone chain.
+	TArray<FVector2D, TInlineAllocator<32>> Points(InPoints);
+	Algo::Sort(Points, [](const FVector2D& A, const FVector2D& B)
+	{
+		return A.X < B.X || (A.X == B.X && A.Y < B.Y);
+	});
+	
+	OutHull.Reset();
+	if (Points.Num() < 3)
+	{
+		OutHull.Append(Points);
+		return;
+	}
+	
+	auto Cross = [](const FVector2D& O, const FVector2D& A, const FVector2D& B)
+	{
+		return (A.X - O.X) * (B.Y - O.Y) - (A.Y - O.Y) * (B.X - O.X);
+	};
+	OutHull.SetNumUninitialized(Points.Num() * 2);
+	int32 Count = 0;
+	for (int32 Index = 0; Index < Points.Num(); Index++)
+	{
+		while (Count >= 2 && Cross(OutHull[Count - 2], OutHull[Count - 1], Points[Index]) <= 0.0)
+		{
+			Count--;
+		}
+		OutHull[Count++] = Points[Index];
+	}
+	for (int32 Index = Points.Num() - 2, Lower = Count + 1; Index >= 0; Index--)
+	{
+		while (Count >= Lower && Cross(OutHull[Count - 2], OutHull[Count - 1], Points[Index]) <= 0.0)
+		{
+			Count--;
+		}
+		OutHull[Count++] = Points[Index];
+	}
+	OutHull.SetNum(Count - 1, EAllowShrinking::No);
+}
\ No newline at end of file
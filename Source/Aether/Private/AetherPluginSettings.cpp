@@ -9,6 +9,21 @@ UAetherPluginSettings::UAetherPluginSettings()
 {
 	SystemMaterialParameterCollection = nullptr;
 	SystemTickMinInterval = 0.013333f;
+	ControllerWeightKernel = EAetherWeightKernel::InverseSquare;
+	ControllerWeightRange = 5000.0f;
+	MaxActiveControllers = 0;
+	ControllerEvaluationDistanceThreshold = 50.0f;
+	ControllerEvaluationMaxInterval = 1.0f;
+	ShelterRecheckDistance = 10.0f;
+	ShelterHashCellSize = 5000.0f;
+	StormHashCellSize = 200000.0f;
+	StormHashSlack = 50000.0f;
+	StormFadeTime = 60.0f;
+	ClimateDryPrecipitation = 1.0f;
+	bEnableCelestialTracking = false;
+	CelestialTrackingResolveInterval = 1.0f;
+	CelestialTrackingMaxAngle = 5.0f;
+	CelestialTrackingErrorThreshold = 0.05f;
 }
 
 FName UAetherPluginSettings::GetCategoryName() const
@@ -0,0 +1,83 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherShelterVolume.h"
+
+#include "AetherWorldSubsystem.h"
+
+AAetherShelterVolume::AAetherShelterVolume()
+{
+	PrecipitationShelter = 1.0f;
+	WindShelter = 1.0f;
+}
+
+void AAetherShelterVolume::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+	
+	if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+	{
+		Subsystem->RegisterShelter(this);
+	}
+}
+
+void AAetherShelterVolume::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+	
+#if WITH_EDITOR
+	if (const UWorld* World = GetWorld())
+	{
+		if (World->WorldType == EWorldType::Type::Editor)
+		{
+			if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+			{
+				// Brush may have changed.
+				Subsystem->RegisterShelter(this);
+			}
+		}
+	}
+#endif
+}
+
+void AAetherShelterVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+	{
+		Subsystem->UnregisterShelter(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void AAetherShelterVolume::Destroyed()
+{
+	if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+	{
+		Subsystem->UnregisterShelter(this);
+	}
+	Super::Destroyed();
+}
+
+#if WITH_EDITOR
+void AAetherShelterVolume::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	
+	if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+	{
+		Subsystem->RegisterShelter(this);
+	}
+}
+
+void AAetherShelterVolume::PostEditMove(bool bFinished)
+{
+	Super::PostEditMove(bFinished);
+	
+	if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+	{
+		Subsystem->RegisterShelter(this);
+	}
+}
+#endif
\ No newline at end of file
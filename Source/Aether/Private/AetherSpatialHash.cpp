@@ -0,0 +1,73 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherSpatialHash.h"
+
+FAetherSpatialHash::FAetherSpatialHash()
+{
+	CellSize = 1.0;
+}
+
+void FAetherSpatialHash::Build(TConstArrayView<FBox> InItems, double InCellSize)
+{
+	Reset();
+	CellSize = FMath::Max(InCellSize, 1.0);
+	Items = InItems;
+	for (int32 Index = 0; Index < Items.Num(); Index++)
+	{
+		const FBox& Item = Items[Index];
+		if (!Item.IsValid)
+		{
+			continue;
+		}
+		const FIntPoint Min = GetCell(Item.Min);
+		const FIntPoint Max = GetCell(Item.Max);
+		if ((int64)(Max.X - Min.X + 1) * (Max.Y - Min.Y + 1) > MaxCellsPerItem)
+		{
+			OversizedItems.Add(Index);
+			continue;
+		}
+		for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+		{
+			for (int32 X = Min.X; X <= Max.X; X++)
+			{
+				Cells.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+			}
+		}
+	}
+}
+
+void FAetherSpatialHash::Reset()
+{
+	Cells.Reset();
+	OversizedItems.Reset();
+	Items.Reset();
+}
+
+void FAetherSpatialHash::QueryPoint(const FVector& Point, TArray<int32>& OutItems) const
+{
+	if (const TArray<int32>* Cell = Cells.Find(GetCell(Point)))
+	{
+		for (const int32 Index : *Cell)
+		{
+			if (Items[Index].IsInsideOrOn(Point))
+			{
+				OutItems.Add(Index);
+			}
+		}
+	}
+	for (const int32 Index : OversizedItems)
+	{
+		if (Items[Index].IsInsideOrOn(Point))
+		{
+			OutItems.Add(Index);
+		}
+	}
+}
+
+FIntPoint FAetherSpatialHash::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
\ No newline at end of file
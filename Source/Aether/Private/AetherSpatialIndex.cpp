@@ -0,0 +1,167 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherSpatialIndex.h"
+
+void FAetherSpatialIndex::Build(TConstArrayView<FBox> InItems)
+{
+	Items = InItems;
+	Nodes.Reset();
+	ItemOrder.SetNumUninitialized(Items.Num());
+	for (int32 Index = 0; Index < Items.Num(); Index++)
+	{
+		ItemOrder[Index] = Index;
+	}
+	if (Items.Num() == 0)
+	{
+		return;
+	}
+	
+	// Top-down, median split on the longest axis of the centers.
+	struct FTask
+	{
+		int32 Node;
+		int32 First;
+		int32 Count;
+	};
+	TArray<FTask, TInlineAllocator<64>> Tasks;
+	Nodes.AddDefaulted();
+	Tasks.Add({ 0, 0, Items.Num() });
+	while (Tasks.Num() > 0)
+	{
+		const FTask Task = Tasks.Pop(EAllowShrinking::No);
+		
+		FBox Bounds(ForceInit);
+		FBox CenterBounds(ForceInit);
+		for (int32 Index = Task.First; Index < Task.First + Task.Count; Index++)
+		{
+			const FBox& Item = Items[ItemOrder[Index]];
+			Bounds += Item;
+			CenterBounds += Item.GetCenter();
+		}
+		Nodes[Task.Node].Bounds = Bounds;
+		
+		if (Task.Count <= LeafSize)
+		{
+			Nodes[Task.Node].First = Task.First;
+			Nodes[Task.Node].Count = Task.Count;
+			continue;
+		}
+		
+		const FVector Extent = CenterBounds.GetExtent();
+		const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+		const int32 Half = Task.Count / 2;
+		int32* Begin = ItemOrder.GetData() + Task.First;
+		std::nth_element(Begin, Begin + Half, Begin + Task.Count, [this, Axis](int32 A, int32 B)
+		{
+			return Items[A].GetCenter()[Axis] < Items[B].GetCenter()[Axis];
+		});
+		
+		const int32 Child = Nodes.AddDefaulted(2);
+		Nodes[Task.Node].First = Child;
+		Nodes[Task.Node].Count = 0;
+		Tasks.Add({ Child, Task.First, Half });
+		Tasks.Add({ Child + 1, Task.First + Half, Task.Count - Half });
+	}
+}
+
+void FAetherSpatialIndex::Refit(TConstArrayView<FBox> InItems)
+{
+	check(InItems.Num() == Items.Num());
+	Items = InItems;
+	for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; NodeIndex--)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		if (Node.Count > 0)
+		{
+			Node.Bounds = FBox(ForceInit);
+			for (int32 Index = Node.First; Index < Node.First + Node.Count; Index++)
+			{
+				Node.Bounds += Items[ItemOrder[Index]];
+			}
+		}
+		else
+		{
+			Node.Bounds = Nodes[Node.First].Bounds + Nodes[Node.First + 1].Bounds;
+		}
+	}
+}
+
+void FAetherSpatialIndex::Reset()
+{
+	Nodes.Reset();
+	ItemOrder.Reset();
+	Items.Reset();
+}
+
+double FAetherSpatialIndex::FindNearestSurfaceDistance(const FVector& Point, FSignedDistanceFunction SignedDistance) const
+{
+	double Nearest = MAX_dbl;
+	if (Nodes.Num() == 0)
+	{
+		return Nearest;
+	}
+	
+	// The box of a node holds all its items, the box distance is a lower bound of their signed distance.
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (FMath::Sqrt(Node.Bounds.ComputeSquaredDistanceToPoint(Point)) >= Nearest)
+		{
+			continue;
+		}
+		if (Node.Count > 0)
+		{
+			for (int32 Index = Node.First; Index < Node.First + Node.Count; Index++)
+			{
+				Nearest = FMath::Min(Nearest, SignedDistance(ItemOrder[Index]));
+			}
+			continue;
+		}
+		
+		// Visit the closer child first so the bound tightens early.
+		const double DistanceA = Nodes[Node.First].Bounds.ComputeSquaredDistanceToPoint(Point);
+		const double DistanceB = Nodes[Node.First + 1].Bounds.ComputeSquaredDistanceToPoint(Point);
+		Stack.Add(DistanceA < DistanceB ? Node.First + 1 : Node.First);
+		Stack.Add(DistanceA < DistanceB ? Node.First : Node.First + 1);
+	}
+	return Nearest;
+}
+
+void FAetherSpatialIndex::QuerySphere(const FVector& Point, double Radius, TArray<int32>& OutItems) const
+{
+	if (Nodes.Num() == 0)
+	{
+		return;
+	}
+	
+	const double RadiusSquared = FMath::Square(FMath::Max(Radius, 0.0));
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(Point) > RadiusSquared)
+		{
+			continue;
+		}
+		if (Node.Count > 0)
+		{
+			for (int32 Index = Node.First; Index < Node.First + Node.Count; Index++)
+			{
+				const int32 ItemIndex = ItemOrder[Index];
+				if (Items[ItemIndex].ComputeSquaredDistanceToPoint(Point) <= RadiusSquared)
+				{
+					OutItems.Add(ItemIndex);
+				}
+			}
+			continue;
+		}
+		Stack.Add(Node.First);
+		Stack.Add(Node.First + 1);
+	}
+}
\ No newline at end of file
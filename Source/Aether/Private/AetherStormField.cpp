@@ -0,0 +1,153 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherStormField.h"
+
+FAetherStormField::FAetherStormField()
+{
+	HashCellSize = 200000.0;
+	HashSlack = 50000.0;
+}
+
+int32 FAetherStormField::Add(const FAetherStormCellDescription& Description)
+{
+	const int32 Index = Locations.Add(Description.Location);
+	Velocities.Add(Description.Velocity);
+	Radii.Add(FMath::Max(Description.Radius, 1.0f));
+	Intensities.Add(FMath::Clamp(Description.Intensity, 0.0f, 1.0f));
+	RemainingLifetimes.Add(Description.Lifetime > 0.0f ? Description.Lifetime : -1.0f);
+	Strengths.Add(Intensities[Index]);
+	Weathers.Add(Description.Weather);
+	const int32 CellId = IdToIndex.Add(Index);
+	IndexToId.Add(CellId);
+	BuildHash();
+	return CellId;
+}
+
+void FAetherStormField::Remove(int32 CellId)
+{
+	if (IdToIndex.IsValidIndex(CellId))
+	{
+		RemoveAtIndex(IdToIndex[CellId]);
+		BuildHash();
+	}
+}
+
+void FAetherStormField::RemoveAtIndex(int32 Index)
+{
+	IdToIndex.RemoveAt(IndexToId[Index]);
+	Locations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Intensities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingLifetimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Strengths.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Weathers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	IndexToId.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (IndexToId.IsValidIndex(Index))
+	{
+		// The last cell moved into the gap.
+		IdToIndex[IndexToId[Index]] = Index;
+	}
+}
+
+void FAetherStormField::Reset()
+{
+	Locations.Reset();
+	Velocities.Reset();
+	Radii.Reset();
+	Intensities.Reset();
+	RemainingLifetimes.Reset();
+	Strengths.Reset();
+	Weathers.Reset();
+	IndexToId.Reset();
+	IdToIndex.Reset();
+	Hash.Reset();
+	HashedLocations.Reset();
+}
+
+void FAetherStormField::Advect(float DeltaTime, const FVector2D& Wind, float FadeTime, double InHashCellSize, double InHashSlack)
+{
+	bool bRebuildHash = InHashCellSize != HashCellSize || InHashSlack != HashSlack;
+	HashCellSize = InHashCellSize;
+	HashSlack = InHashSlack;
+	if (Locations.Num() == 0)
+	{
+		return;
+	}
+	
+	const FVector WindVelocity(Wind.X, Wind.Y, 0.0);
+	const double SlackSquared = FMath::Square(HashSlack);
+	for (int32 Index = 0; Index < Locations.Num(); Index++)
+	{
+		Locations[Index] += (Velocities[Index] + WindVelocity) * DeltaTime;
+		bRebuildHash |= FVector2D::DistSquared(FVector2D(Locations[Index]), FVector2D(HashedLocations[Index])) > SlackSquared;
+	}
+	
+	for (int32 Index = Locations.Num() - 1; Index >= 0; Index--)
+	{
+		if (RemainingLifetimes[Index] < 0.0f)
+		{
+			continue;
+		}
+		RemainingLifetimes[Index] -= DeltaTime;
+		if (RemainingLifetimes[Index] <= 0.0f)
+		{
+			RemoveAtIndex(Index);
+			bRebuildHash = true;
+		}
+	}
+	
+	if (bRebuildHash)
+	{
+		BuildHash();
+	}
+	
+	for (int32 Index = 0; Index < Strengths.Num(); Index++)
+	{
+		const float Fade = RemainingLifetimes[Index] < 0.0f || FadeTime <= 0.0f ? 1.0f : FMath::Min(RemainingLifetimes[Index] / FadeTime, 1.0f);
+		Strengths[Index] = Intensities[Index] * Fade;
+	}
+}
+
+void FAetherStormField::BuildHash()
+{
+	// Storms are columns, only the distance in the XY plane counts.
+	HashedLocations = Locations;
+	Bounds.SetNumUninitialized(Locations.Num(), EAllowShrinking::No);
+	for (int32 Index = 0; Index < Locations.Num(); Index++)
+	{
+		const FVector& Location = Locations[Index];
+		const double Extent = Radii[Index] + HashSlack;
+		Bounds[Index] = FBox(FVector(Location.X - Extent, Location.Y - Extent, -UE_OLD_HALF_WORLD_MAX), FVector(Location.X + Extent, Location.Y + Extent, UE_OLD_HALF_WORLD_MAX));
+	}
+	Hash.Build(Bounds, HashCellSize);
+}
+
+void FAetherStormField::Evaluate(const FVector& Location, TArray<int32>& Candidates, TArray<TPair<int32, float>>& OutWeights) const
+{
+	OutWeights.Reset();
+	if (Locations.Num() == 0)
+	{
+		return;
+	}
+	// The hashed bounds are grown by the slack, test against the current location.
+	Candidates.Reset();
+	Hash.QueryPoint(Location, Candidates);
+	for (const int32 Index : Candidates)
+	{
+		const double DistSquared = FVector2D::DistSquared(FVector2D(Location), FVector2D(Locations[Index]));
+		if (DistSquared < FMath::Square((double)Radii[Index]))
+		{
+			// Smoothstep falloff, as the children of an area controller.
+			const float Q = (float)(FMath::Sqrt(DistSquared) / Radii[Index]);
+			const float Weight = Strengths[Index] * (1.0f - Q * Q * (3.0f - 2.0f * Q));
+			if (Weight > 0.0f)
+			{
+				OutWeights.Emplace(Index, Weight);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 #include "AetherTypes.h"
 
+#include "AetherInfluenceShape.h"
+
 FAetherState::FAetherState()
 {
 	Latitude = 0.0f;
@@ -13,6 +15,9 @@ FAetherState::FAetherState()
 	Month = EAetherMonth::January;
 	SunLightDirection = FVector::ZeroVector;
 	MoonLightDirection = FVector::ZeroVector;
+	MoonPhaseAngle = 0.0f;
+	MoonIlluminatedFraction = 0.0f;
+	MoonIlluminance = 0.0f;
 	AirTemperature = 0.0f;
 	GroundTemperature = 0.0f;
 	RainFall = 0.0f;
@@ -24,6 +29,8 @@ FAetherState::FAetherState()
 	DustIntensity = 0.0f;
 	FogIntensity = 0.0f;
 	CloudCoverage = 0.0f;
+	PrecipitationShelter = 0.0f;
+	WindShelter = 0.0f;
 	
 	Time = 0.0;
 	
@@ -38,6 +45,9 @@ FString FAetherState::ToString() const
 	Result += FString("ProgressOfYear: ") + FString::SanitizeFloat(ProgressOfYear) + "\n";
 	Result += FString("SunLightDirection: ") + SunLightDirection.ToString() + "\n";
 	Result += FString("MoonLightDirection: ") + MoonLightDirection.ToString() + "\n";
+	Result += FString("MoonPhaseAngle: ") + FString::SanitizeFloat(MoonPhaseAngle) + "\n";
+	Result += FString("MoonIlluminatedFraction: ") + FString::SanitizeFloat(MoonIlluminatedFraction) + "\n";
+	Result += FString("MoonIlluminance: ") + FString::SanitizeFloat(MoonIlluminance) + "\n";
 	Result += FString("AirTemperature: ") + FString::SanitizeFloat(AirTemperature) + "\n";
 	Result += FString("GroundTemperature: ") + FString::SanitizeFloat(GroundTemperature) + "\n";
 	Result += FString("RainFall: ") + FString::SanitizeFloat(RainFall) + "\n";
@@ -48,6 +58,8 @@ FString FAetherState::ToString() const
 	Result += FString("WindData: ") + WindData.ToString() + "\n";
 	Result += FString("DustIntensity: ") + FString::SanitizeFloat(DustIntensity) + "\n";
 	Result += FString("FogIntensity: ") + FString::SanitizeFloat(FogIntensity) + "\n";
+	Result += FString("PrecipitationShelter: ") + FString::SanitizeFloat(PrecipitationShelter) + "\n";
+	Result += FString("WindShelter: ") + FString::SanitizeFloat(WindShelter) + "\n";
 	
 	Result += FString("Time: ") + FString::SanitizeFloat(Time) + "\n";
 	
@@ -63,6 +75,9 @@ void FAetherState::Reset()
 	Month = EAetherMonth::January;
 	SunLightDirection = FVector::ZeroVector;
 	MoonLightDirection = FVector::ZeroVector;
+	MoonPhaseAngle = 0.0f;
+	MoonIlluminatedFraction = 0.0f;
+	MoonIlluminance = 0.0f;
 	AirTemperature = 0.0f;
 	GroundTemperature = 0.0f;
 	RainFall = 0.0f;
@@ -73,6 +88,8 @@ void FAetherState::Reset()
 	WindData = FVector4f::Zero();
 	DustIntensity = 0.0f;
 	FogIntensity = 0.0f;
+	PrecipitationShelter = 0.0f;
+	WindShelter = 0.0f;
 	
 	Time = 0.0;
 	
@@ -86,41 +103,267 @@ void FAetherState::Normalize()
 	MoonLightDirection.Normalize();
 }
 
-FAetherState FAetherState::operator*(float Operand)
+namespace AetherStateFields
+{
+	constexpr FAetherStateField Fields[] =
+	{
+		{ STRUCT_OFFSET(FAetherState, Latitude), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Celestial, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, Longitude), EAetherStateFieldType::Float, EAetherStateBlendMode::Angular, EAetherStateFieldGroup::Celestial, -180.0f, 360.0f },
+		{ STRUCT_OFFSET(FAetherState, ProgressOfYear), EAetherStateFieldType::Float, EAetherStateBlendMode::Angular, EAetherStateFieldGroup::Celestial, 0.0f, 1.0f },
+		{ STRUCT_OFFSET(FAetherState, SunLightDirection), EAetherStateFieldType::Vector, EAetherStateBlendMode::NormalizedVector, EAetherStateFieldGroup::Celestial, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, MoonLightDirection), EAetherStateFieldType::Vector, EAetherStateBlendMode::NormalizedVector, EAetherStateFieldGroup::Celestial, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, MoonPhaseAngle), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Celestial, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, MoonIlluminatedFraction), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Celestial, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, MoonIlluminance), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Celestial, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, Time), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Celestial, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, AirTemperature), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, GroundTemperature), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, RainFall), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, SnowFall), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, SurfaceRainRemain), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, PuddleRainRemain), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, SurfaceSnowDepth), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, WindData), EAetherStateFieldType::Vector4f, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, DustIntensity), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, FogIntensity), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+		{ STRUCT_OFFSET(FAetherState, CloudCoverage), EAetherStateFieldType::Float, EAetherStateBlendMode::Linear, EAetherStateFieldGroup::Weather, 0.0f, 0.0f },
+	};
+	
+	constexpr int32 GetNumComponents(EAetherStateFieldType Type)
+	{
+		return Type == EAetherStateFieldType::Float ? 1 : Type == EAetherStateFieldType::Vector ? 3 : 4;
+	}
+	
+	constexpr int32 GetComponentSize(EAetherStateFieldType Type)
+	{
+		return Type == EAetherStateFieldType::Vector ? sizeof(FVector::FReal) : sizeof(float);
+	}
+	
+	// Angular fields blend as cosine and sine.
+	constexpr int32 GetNumLanes(const FAetherStateField& Field)
+	{
+		return Field.BlendMode == EAetherStateBlendMode::Angular ? 2 : GetNumComponents(Field.Type);
+	}
+	
+	constexpr int32 CountLanes()
+	{
+		int32 Count = 0;
+		for (const FAetherStateField& Field : Fields)
+		{
+			Count += GetNumLanes(Field);
+		}
+		return Count;
+	}
+	
+	constexpr int32 NumLanes = CountLanes();
+	
+	void ReadComponents(const FAetherStateField& Field, const uint8* Data, float* OutValues)
+	{
+		for (int32 Component = 0; Component < GetNumComponents(Field.Type); Component++)
+		{
+			OutValues[Component] = Field.Type == EAetherStateFieldType::Vector ? (float)reinterpret_cast<const FVector::FReal*>(Data)[Component] : reinterpret_cast<const float*>(Data)[Component];
+		}
+	}
+	
+	void WriteComponents(const FAetherStateField& Field, uint8* Data, const float* Values)
+	{
+		for (int32 Component = 0; Component < GetNumComponents(Field.Type); Component++)
+		{
+			if (Field.Type == EAetherStateFieldType::Vector)
+			{
+				reinterpret_cast<FVector::FReal*>(Data)[Component] = Values[Component];
+			}
+			else
+			{
+				reinterpret_cast<float*>(Data)[Component] = Values[Component];
+			}
+		}
+	}
+	
+	/**
+	 * Lays the fields of Groups out as flat float lanes, the lanes of other fields are left untouched.
+	 */
+	void LoadLanes(const FAetherState& State, EAetherStateFieldGroup Groups, float* Lanes)
+	{
+		const uint8* Base = reinterpret_cast<const uint8*>(&State);
+		for (const FAetherStateField& Field : Fields)
+		{
+			if (EnumHasAnyFlags(Field.Group, Groups))
+			{
+				ReadComponents(Field, Base + Field.Offset, Lanes);
+				if (Field.BlendMode == EAetherStateBlendMode::Angular)
+				{
+					FMath::SinCos(&Lanes[1], &Lanes[0], Lanes[0] * UE_TWO_PI / Field.Period);
+				}
+			}
+			Lanes += GetNumLanes(Field);
+		}
+	}
+	
+	void StoreLanes(const float* Sums, float InvWeightSum, EAetherStateFieldGroup Groups, FAetherState& Out)
+	{
+		uint8* Base = reinterpret_cast<uint8*>(&Out);
+		int32 Lane = 0;
+		for (const FAetherStateField& Field : Fields)
+		{
+			if (EnumHasAnyFlags(Field.Group, Groups))
+			{
+				const int32 NumComponents = GetNumComponents(Field.Type);
+				float Values[4];
+				switch (Field.BlendMode)
+				{
+				case EAetherStateBlendMode::Linear:
+					for (int32 Component = 0; Component < NumComponents; Component++)
+					{
+						Values[Component] = Sums[Lane + Component] * InvWeightSum;
+					}
+					break;
+				case EAetherStateBlendMode::NormalizedVector:
+					{
+						float LengthSquared = 0.0f;
+						for (int32 Component = 0; Component < NumComponents; Component++)
+						{
+							LengthSquared += FMath::Square(Sums[Lane + Component]);
+						}
+						const float InvLength = LengthSquared > UE_SMALL_NUMBER ? FMath::InvSqrt(LengthSquared) : 0.0f;
+						for (int32 Component = 0; Component < NumComponents; Component++)
+						{
+							Values[Component] = Sums[Lane + Component] * InvLength;
+						}
+					}
+					break;
+				case EAetherStateBlendMode::Angular:
+					{
+						const float Angle = FMath::Atan2(Sums[Lane + 1], Sums[Lane]) * Field.Period / UE_TWO_PI;
+						float Wrapped = FMath::Fmod(Angle - Field.Min, Field.Period);
+						Wrapped += Wrapped < 0.0f ? Field.Period : 0.0f;
+						Values[0] = Field.Min + Wrapped;
+					}
+					break;
+				}
+				WriteComponents(Field, Base + Field.Offset, Values);
+			}
+			Lane += GetNumLanes(Field);
+		}
+	}
+}
+
+TConstArrayView<FAetherStateField> FAetherState::GetFields()
+{
+	return AetherStateFields::Fields;
+}
+
+void FAetherState::BlendN(TConstArrayView<const FAetherState*> States, TConstArrayView<float> Weights, FAetherState& Out, EAetherStateFieldGroup Groups)
 {
-	FAetherState Result;
-	Result.ProgressOfYear = ProgressOfYear * Operand;
-	Result.SunLightDirection = SunLightDirection * Operand;
-	Result.MoonLightDirection = MoonLightDirection * Operand;
+	using namespace AetherStateFields;
+	check(States.Num() == Weights.Num());
 	
-	Result.SurfaceRainRemain = SurfaceRainRemain * Operand;
-	Result.PuddleRainRemain = PuddleRainRemain * Operand;
+	// Every state is accumulated over the same flat lanes, the inner loop has no branch on the field.
+	float Lanes[NumLanes] = {};
+	float Sums[NumLanes] = {};
 	
-	Result.Time = Time * Operand;
+	float WeightSum = 0.0f;
+	for (int32 Index = 0; Index < States.Num(); Index++)
+	{
+		const float Weight = Weights[Index];
+		if (Weight <= 0.0f)
+		{
+			continue;
+		}
+		LoadLanes(*States[Index], Groups, Lanes);
+		for (int32 Lane = 0; Lane < NumLanes; Lane++)
+		{
+			Sums[Lane] += Lanes[Lane] * Weight;
+		}
+		WeightSum += Weight;
+	}
 	
-	Result.TestValue = TestValue * Operand;
+	if (WeightSum > 0.0f)
+	{
+		StoreLanes(Sums, 1.0f / WeightSum, Groups, Out);
+	}
+}
+
+void FAetherState::CopyFields(const FAetherState& From, EAetherStateFieldGroup Groups)
+{
+	for (const FAetherStateField& Field : AetherStateFields::Fields)
+	{
+		if (EnumHasAnyFlags(Field.Group, Groups))
+		{
+			const int32 Size = AetherStateFields::GetNumComponents(Field.Type) * AetherStateFields::GetComponentSize(Field.Type);
+			FMemory::Memcpy(reinterpret_cast<uint8*>(this) + Field.Offset, reinterpret_cast<const uint8*>(&From) + Field.Offset, Size);
+		}
+	}
+}
+
+FAetherState FAetherState::operator*(float Operand)
+{
+	FAetherState Result = *this;
+	for (const FAetherStateField& Field : AetherStateFields::Fields)
+	{
+		float Values[4];
+		AetherStateFields::ReadComponents(Field, reinterpret_cast<const uint8*>(this) + Field.Offset, Values);
+		for (int32 Component = 0; Component < AetherStateFields::GetNumComponents(Field.Type); Component++)
+		{
+			Values[Component] *= Operand;
+		}
+		AetherStateFields::WriteComponents(Field, reinterpret_cast<uint8*>(&Result) + Field.Offset, Values);
+	}
 	return Result;
 }
 
 FAetherState FAetherState::operator+(const FAetherState& Another)
 {
-	FAetherState Result;
-	Result.ProgressOfYear = ProgressOfYear + Another.ProgressOfYear;
-	Result.SunLightDirection = SunLightDirection + Another.SunLightDirection;
-	Result.MoonLightDirection = MoonLightDirection + Another.MoonLightDirection;
-	Result.AirTemperature = AirTemperature + Another.AirTemperature;
-	Result.GroundTemperature = GroundTemperature + Another.GroundTemperature;
-	Result.RainFall = RainFall + Another.RainFall;
-	Result.SnowFall = SnowFall + Another.SnowFall;
-	Result.SurfaceRainRemain = SurfaceRainRemain + Another.SurfaceRainRemain;
-	Result.PuddleRainRemain = PuddleRainRemain + Another.PuddleRainRemain;
-	Result.SurfaceSnowDepth = SurfaceSnowDepth + Another.SurfaceSnowDepth;
-	Result.WindData = WindData + Another.WindData;
-	Result.DustIntensity = DustIntensity + Another.DustIntensity;
-	Result.FogIntensity = FogIntensity + Another.FogIntensity;
-	
-	Result.Time = Time + Another.Time;
-	
-	Result.TestValue = TestValue + Another.TestValue;
+	FAetherState Result = *this;
+	for (const FAetherStateField& Field : AetherStateFields::Fields)
+	{
+		float Values[4];
+		float AnotherValues[4];
+		AetherStateFields::ReadComponents(Field, reinterpret_cast<const uint8*>(this) + Field.Offset, Values);
+		AetherStateFields::ReadComponents(Field, reinterpret_cast<const uint8*>(&Another) + Field.Offset, AnotherValues);
+		for (int32 Component = 0; Component < AetherStateFields::GetNumComponents(Field.Type); Component++)
+		{
+			Values[Component] += AnotherValues[Component];
+		}
+		AetherStateFields::WriteComponents(Field, reinterpret_cast<uint8*>(&Result) + Field.Offset, Values);
+	}
 	return Result;
+}
+
+FAetherAreaControllerProxy::FAetherAreaControllerProxy()
+{
+	Priority = 0;
+	Transform = FTransform::Identity;
+	InfluenceShape = EAetherInfluenceShape::Sphere;
+	AffectRadius = 1000.0f;
+	InfluenceExtent = FVector(1000.0f);
+	DaytimeSpeedScale = 1.0f;
+	NightSpeedScale = 1.0f;
+	EvaporationCapacity = 500.0f;
+	SurfaceWater = 0.0f;
+	bHasSnapshot = false;
+}
+
+void FAetherAreaControllerProxy::BuildInfluenceShape(FAetherInfluenceShape& OutShape) const
+{
+	switch (InfluenceShape)
+	{
+	case EAetherInfluenceShape::Box:
+		OutShape.SetBox(Transform, InfluenceExtent);
+		break;
+	case EAetherInfluenceShape::Convex:
+		OutShape.SetConvex(Transform, InfluenceConvexPoints, InfluenceExtent.Z);
+		break;
+	case EAetherInfluenceShape::Spline:
+		if (InfluencePolyline.Num() > 0)
+		{
+			OutShape.SetCorridor(InfluencePolyline, AffectRadius);
+			break;
+		}
+		// Fall back to the sphere without a spline.
+		[[fallthrough]];
+	default:
+		OutShape.SetSphere(Transform.GetLocation(), AffectRadius);
+		break;
+	}
 }
\ No newline at end of file
@@ -5,20 +5,52 @@
 
 #include "AetherWorldSubsystem.h"
 
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
 #include "Kismet/KismetMaterialLibrary.h"
 #include "Materials/MaterialParameterCollection.h"
 #include "Subsystems/SubsystemBlueprintLibrary.h"
 
+#include "Aether.h"
 #include "AetherAreaController.h"
+#include "AetherBackgroundController.h"
 #include "AetherCloudAvatar.h"
 #include "AetherControllerBase.h"
 #include "AetherGlobalController.h"
 #include "AetherLightingAvatar.h"
 #include "AetherPluginSettings.h"
+#include "AetherPuddleAvatar.h"
+#include "AetherShelterVolume.h"
 #include "AetherStats.h"
 
 #include "AetherWorldMath.inl"
 
+#ifndef AETHER_MATH_FAST_PATH
+#define AETHER_MATH_FAST_PATH 0
+#endif
+
+static TAutoConsoleVariable<int32> CVarAetherMathFastPath(
+	TEXT("at.Math.FastPath"),
+	AETHER_MATH_FAST_PATH,
+	TEXT("1 solves the sun and moon with the polynomial approximation of FAetherFastMath (about 0.01 degree), 0 uses the engine trigonometry."),
+	ECVF_Scalability);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdAdvanceAetherTime(
+	TEXT("a.AdvanceAetherTime"),
+	TEXT("Jump the Aether simulated time ahead without stepping. Usage: a.AdvanceAetherTime <Hours>"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.Num() > 0 && World)
+		{
+			if (UAetherWorldSubsystem* Subsystem = World->GetSubsystem<UAetherWorldSubsystem>())
+			{
+				Subsystem->AdvanceBy(FCString::Atod(*Args[0]) * SECONDS_PER_HOUR);
+			}
+		}
+	}),
+	ECVF_Cheat);
+
 #if UE_ENABLE_DEBUG_DRAWING
 static TAutoConsoleVariable<int32> CVarVisualizeAetherState(
 	TEXT("a.VisualizeAetherState"),
@@ -39,11 +71,34 @@ static TAutoConsoleVariable<int32> CVarVisualizeAetherControllerPoint(
 	ECVF_Cheat);
 #endif
 
+FAetherStreamingSource::FAetherStreamingSource()
+{
+	Location = FVector::ZeroVector;
+	State.Reset();
+	bHasClimate = false;
+	LastEvaluationLocation = FVector::ZeroVector;
+	LastEvaluationTime = 0.0;
+	bDirty = true;
+	PrecipitationShelter = 0.0f;
+	WindShelter = 0.0f;
+	LastShelterLocation = FVector::ZeroVector;
+	bShelterDirty = true;
+	bGathered = false;
+}
+
 UAetherWorldSubsystem::UAetherWorldSubsystem()
 {
 	LightingAvatar = nullptr;
 	CloudAvatar = nullptr;
 	SystemMaterialParameterCollection = nullptr;
+	MoonPhaseCachedDay = INDEX_NONE;
+	MoonAgeAngleOfDay = FVector2f::ZeroVector;
+	UpdateSystemState_DielRhythm_Planet = &UAetherWorldSubsystem::UpdateSystemState_DielRhythm_Earth;
+	CustomPrimarySunIndex = INDEX_NONE;
+	CustomPrimaryMoonIndex = INDEX_NONE;
+	bAreaControllerIndexDirty = true;
+	bAreaControllerBoundsDirty = false;
+	bShelterHashDirty = true;
 }
 
 bool UAetherWorldSubsystem::ShouldCreateSubsystem(UObject* Outer) const
@@ -73,15 +128,36 @@ void UAetherWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	}
 	
 	GlobalController = nullptr;
+	BackgroundController = nullptr;
 	AreaControllers.Empty();
-	ActiveControllers.Empty();
-	Avatars.Empty();
+	AreaControllerProxies.Empty();
+	AreaControllerSlots.Empty();
+	AreaControllerSlotHandles.Empty();
+	AreaControllerHandles.Empty();
+	StreamingSources.Empty();
+	ShelterVolumes.Empty();
+	bShelterHashDirty = true;
+	StormField.Reset();
+	LightingAvatars.Empty();
+	CloudAvatars.Empty();
+	PuddleAvatars.Empty();
+	OtherAvatars.Empty();
+	AvatarHandles.Empty();
+	for (TArray<int32>& TypeHandles : AvatarSlotHandles)
+	{
+		TypeHandles.Empty();
+	}
 	LightingAvatar = nullptr;
 	CloudAvatar = nullptr;
 	SystemState.Reset();
 	StreamingSourceLocation = FVector4f::Zero();
 	StreamingSourceLocation.W = -1.0f;
 	
+	if (!EphemerisTable.IsBuilt())
+	{
+		EphemerisTable.Build();
+	}
+	
 #if WITH_EDITOR
 	if (UWorld* World = GetWorld())
 	{
@@ -163,18 +239,29 @@ void UAetherWorldSubsystem::Tick(float DeltaTime)
 	if (CVarVisualizeAetherControllerWeight.GetValueOnGameThread() > 0 && GEngine)
 	{
 		FString DebugString = FString("Aether Controllers weight map:\n");
-		for (auto It = ActiveControllers.CreateConstIterator(); It; ++It)
+		for (int32 SourceIndex = 0; SourceIndex < StreamingSources.Num(); SourceIndex++)
 		{
-			DebugString += It.Key()->GetActorLabel() + FString(": ") + FString::SanitizeFloat(It.Value()) + FString("\n");
+			const FAetherActiveControllerView ActiveControllers = GetActiveControllers(SourceIndex);
+			DebugString += FString::Printf(TEXT("Source %d:\n"), SourceIndex);
+			for (int32 Index = 0; Index < ActiveControllers.Num(); Index++)
+			{
+				const AAetherAreaController* Controller = ActiveControllers.GetController(Index);
+				const FString Label = Controller ? Controller->GetActorLabel() : FString("Proxy ") + ActiveControllers.GetProxy(Index).ProxyId.ToString();
+				DebugString += Label + FString(": ") + FString::SanitizeFloat(ActiveControllers.GetWeight(Index)) + FString("\n");
+			}
 		}
 		GEngine->AddOnScreenDebugMessage((uint64)this + 1, 1.0f, FColor::Green, DebugString);
 	}
 	
 	if (CVarVisualizeAetherControllerPoint.GetValueOnGameThread() > 0 && GEngine)
 	{
-		for (auto It = ActiveControllers.CreateConstIterator(); It; ++It)
+		const FAetherActiveControllerView ActiveControllers = GetActiveControllers();
+		for (int32 Index = 0; Index < ActiveControllers.Num(); Index++)
 		{
-			It.Key()->DrawDebugPointInfo(FMath::Lerp(FLinearColor::Red, FLinearColor::Green, It.Value()).ToFColor(true));
+			if (const AAetherAreaController* Controller = ActiveControllers.GetController(Index))
+			{
+				Controller->DrawDebugPointInfo(FMath::Lerp(FLinearColor::Red, FLinearColor::Green, ActiveControllers.GetWeight(Index)).ToFColor(true));
+			}
 		}
 	}
 #endif
@@ -201,13 +288,71 @@ void UAetherWorldSubsystem::RegisterController(AAetherControllerBase* InControll
 	{
 		return;
 	}
+	if (AAetherBackgroundController* LocalBackgroundController = Cast<AAetherBackgroundController>(InController))
+	{
+		// Spawned by UpdateBackgroundController, not weighted by location.
+		BackgroundController = LocalBackgroundController;
+		return;
+	}
 	if (AAetherGlobalController* LocalGlobalController = Cast<AAetherGlobalController>(InController))
 	{
 		GlobalController = LocalGlobalController;
 	}
 	else if (AAetherAreaController* AreaController = Cast<AAetherAreaController>(InController))
 	{
-		AreaControllers.AddUnique(AreaController);
+		if (IsAreaControllerRegistered(AreaController))
+		{
+			// Construction script ran again, e.g. after editing the spline.
+			MarkAreaControllerDirty(AreaController, true);
+		}
+		else
+		{
+			int32 SlotIndex = INDEX_NONE;
+			if (const int32* ProxySlotIndex = AreaControllerSlots.Find(AreaController->ProxyId))
+			{
+				if (AreaControllers[*ProxySlotIndex])
+				{
+					UE_LOG(LogAether, Warning, TEXT("Area controller %s shares its proxy id with %s, a new one is assigned."), *AreaController->GetName(), *AreaControllers[*ProxySlotIndex]->GetName());
+					AreaController->ProxyId = FGuid();
+				}
+				else
+				{
+					// Streamed in again, or the cell of a baked proxy loaded.
+					SlotIndex = *ProxySlotIndex;
+				}
+			}
+			if (!AreaController->ProxyId.IsValid())
+			{
+				AreaController->ProxyId = FGuid::NewGuid();
+			}
+			
+			if (SlotIndex == INDEX_NONE)
+			{
+				SlotIndex = AreaControllers.Add(AreaController);
+				AreaControllerProxies.AddDefaulted();
+				AreaControllerSlotHandles.Add(INDEX_NONE);
+				AreaControllerSlots.Add(AreaController->ProxyId, SlotIndex);
+			}
+			else
+			{
+				AreaControllers[SlotIndex] = AreaController;
+				FAetherAreaControllerProxy& Proxy = AreaControllerProxies[SlotIndex];
+				if (Proxy.bHasSnapshot)
+				{
+					AreaController->ApplyProxySnapshot(Proxy);
+					Proxy.bHasSnapshot = false;
+				}
+			}
+			AreaController->MakeProxy(AreaControllerProxies[SlotIndex]);
+			AreaController->RegistrationHandle = AreaControllerHandles.Add(SlotIndex);
+			AreaControllerSlotHandles[SlotIndex] = AreaController->RegistrationHandle;
+			
+			if (USceneComponent* ControllerRoot = AreaController->GetRootComponent())
+			{
+				ControllerRoot->TransformUpdated.AddUObject(this, &UAetherWorldSubsystem::OnAreaControllerTransformUpdated);
+			}
+			bAreaControllerIndexDirty = true;
+		}
 	}
 	
 #if WITH_EDITOR
@@ -232,28 +377,167 @@ void UAetherWorldSubsystem::UnregisterController(AAetherControllerBase* InContro
 	{
 		GlobalController = nullptr;
 	}
+	else if (BackgroundController == InController)
+	{
+		BackgroundController = nullptr;
+	}
 	else if (AAetherAreaController* AreaController = Cast<AAetherAreaController>(InController))
 	{
-		AreaControllers.Remove(AreaController);
-		ActiveControllers.Remove(AreaController);
+		if (IsAreaControllerRegistered(AreaController))
+		{
+			const int32 SlotIndex = AreaControllerHandles[AreaController->RegistrationHandle];
+			AreaControllerHandles.RemoveAt(AreaController->RegistrationHandle);
+			AreaController->RegistrationHandle = INDEX_NONE;
+			AreaControllerSlots.Remove(AreaControllerProxies[SlotIndex].ProxyId);
+			
+			AreaControllers.RemoveAtSwap(SlotIndex, 1, EAllowShrinking::No);
+			AreaControllerProxies.RemoveAtSwap(SlotIndex, 1, EAllowShrinking::No);
+			AreaControllerSlotHandles.RemoveAtSwap(SlotIndex, 1, EAllowShrinking::No);
+			if (AreaControllerProxies.IsValidIndex(SlotIndex))
+			{
+				// The last slot moved into the gap.
+				AreaControllerSlots[AreaControllerProxies[SlotIndex].ProxyId] = SlotIndex;
+				if (AreaControllerSlotHandles[SlotIndex] != INDEX_NONE)
+				{
+					AreaControllerHandles[AreaControllerSlotHandles[SlotIndex]] = SlotIndex;
+				}
+			}
+			
+			if (USceneComponent* ControllerRoot = AreaController->GetRootComponent())
+			{
+				ControllerRoot->TransformUpdated.RemoveAll(this);
+			}
+			bAreaControllerIndexDirty = true;
+			
+			// The last controller moved into the slot of the removed one.
+			for (FAetherStreamingSource& Source : StreamingSources)
+			{
+				Source.ActiveControllerIndices.Reset();
+				Source.ActiveControllerWeights.Reset();
+				Source.bDirty = true;
+			}
+		}
 	}
 }
 
-void UAetherWorldSubsystem::RegisterAvatar(AAetherAvatarBase* InAvatar)
+void UAetherWorldSubsystem::DetachAreaController(AAetherAreaController* InController)
 {
-	if (!InAvatar)
+	if (!IsAreaControllerRegistered(InController))
 	{
 		return;
 	}
-	if (AAetherLightingAvatar* InLightingAvatar = Cast<AAetherLightingAvatar>(InAvatar))
+	const int32 SlotIndex = AreaControllerHandles[InController->RegistrationHandle];
+	AreaControllerHandles.RemoveAt(InController->RegistrationHandle);
+	InController->RegistrationHandle = INDEX_NONE;
+	AreaControllerSlotHandles[SlotIndex] = INDEX_NONE;
+	
+	FAetherAreaControllerProxy& Proxy = AreaControllerProxies[SlotIndex];
+	InController->MakeProxy(Proxy);
+	Proxy.bHasSnapshot = true;
+	AreaControllers[SlotIndex] = nullptr;
+	if (USceneComponent* ControllerRoot = InController->GetRootComponent())
 	{
-		LightingAvatar = InLightingAvatar;
+		ControllerRoot->TransformUpdated.RemoveAll(this);
 	}
-	else if (AAetherCloudAvatar* InCloudAvatar = Cast<AAetherCloudAvatar>(InAvatar))
+	// Same slot, shape and hierarchy, the weights of the streaming sources stay valid.
+}
+
+bool UAetherWorldSubsystem::IsAreaControllerRegistered(const AAetherAreaController* InController) const
+{
+	// The handle may be left over from another world or an earlier initialization.
+	return InController
+		&& AreaControllerHandles.IsValidIndex(InController->RegistrationHandle)
+		&& AreaControllers[AreaControllerHandles[InController->RegistrationHandle]] == InController;
+}
+
+void UAetherWorldSubsystem::NotifyAreaControllerBoundsChanged(AAetherAreaController* InController)
+{
+	MarkAreaControllerDirty(InController, true);
+}
+
+void UAetherWorldSubsystem::NotifyAreaControllerDataChanged(AAetherAreaController* InController)
+{
+	MarkAreaControllerDirty(InController, false);
+}
+
+void UAetherWorldSubsystem::MarkAreaControllerDirty(const AAetherAreaController* InController, bool bBoundsChanged)
+{
+	if (IsAreaControllerRegistered(InController))
+	{
+		DirtyAreaControllerSlots.AddUnique(AreaControllerHandles[InController->RegistrationHandle]);
+		bAreaControllerBoundsDirty |= bBoundsChanged;
+	}
+}
+
+void UAetherWorldSubsystem::NotifyAreaControllerHierarchyChanged(AAetherAreaController* InController)
+{
+	if (IsAreaControllerRegistered(InController))
+	{
+		bAreaControllerIndexDirty = true;
+	}
+}
+
+void UAetherWorldSubsystem::OnAreaControllerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	MarkAreaControllerDirty(Cast<AAetherAreaController>(UpdatedComponent->GetOwner()), true);
+}
+
+void UAetherWorldSubsystem::RegisterShelter(AAetherShelterVolume* InShelter)
+{
+	if (InShelter)
+	{
+		ShelterVolumes.AddUnique(InShelter);
+		bShelterHashDirty = true;
+	}
+}
+
+void UAetherWorldSubsystem::UnregisterShelter(AAetherShelterVolume* InShelter)
+{
+	if (ShelterVolumes.Remove(InShelter) > 0)
 	{
-		CloudAvatar = InCloudAvatar;
+		bShelterHashDirty = true;
+	}
+}
+
+int32 UAetherWorldSubsystem::SpawnStormCell(const FAetherStormCellDescription& Description)
+{
+	return StormField.Add(Description);
+}
+
+void UAetherWorldSubsystem::RemoveStormCell(int32 CellId)
+{
+	StormField.Remove(CellId);
+}
+
+void UAetherWorldSubsystem::RegisterAvatar(AAetherAvatarBase* InAvatar)
+{
+	if (!InAvatar)
+	{
+		return;
+	}
+	if (!IsAvatarRegistered(InAvatar))
+	{
+		EAetherAvatarType Type = EAetherAvatarType::Other;
+		if (AAetherLightingAvatar* InLightingAvatar = Cast<AAetherLightingAvatar>(InAvatar))
+		{
+			LightingAvatar = InLightingAvatar;
+			Type = EAetherAvatarType::Lighting;
+		}
+		else if (AAetherCloudAvatar* InCloudAvatar = Cast<AAetherCloudAvatar>(InAvatar))
+		{
+			CloudAvatar = InCloudAvatar;
+			Type = EAetherAvatarType::Cloud;
+		}
+		else if (InAvatar->IsA<AAetherPuddleAvatarBase>())
+		{
+			Type = EAetherAvatarType::Puddle;
+		}
+		FAetherAvatarSlot Slot;
+		Slot.Type = Type;
+		Slot.Index = GetAvatars(Type).Add(InAvatar);
+		InAvatar->RegistrationHandle = AvatarHandles.Add(Slot);
+		AvatarSlotHandles[(int32)Type].Add(InAvatar->RegistrationHandle);
 	}
-	Avatars.AddUnique(InAvatar);
 	
 #if WITH_EDITOR
 	if (const UWorld* World = GetWorld())
@@ -273,15 +557,58 @@ void UAetherWorldSubsystem::UnregisterAvatar(AAetherAvatarBase* InAvatar)
 	{
 		return;
 	}
+	if (!IsAvatarRegistered(InAvatar))
+	{
+		return;
+	}
+	const FAetherAvatarSlot Slot = AvatarHandles[InAvatar->RegistrationHandle];
+	AvatarHandles.RemoveAt(InAvatar->RegistrationHandle);
+	InAvatar->RegistrationHandle = INDEX_NONE;
+	
+	TArray<TObjectPtr<AAetherAvatarBase>>& TypeAvatars = GetAvatars(Slot.Type);
+	TArray<int32>& TypeHandles = AvatarSlotHandles[(int32)Slot.Type];
+	TypeAvatars.RemoveAtSwap(Slot.Index, 1, EAllowShrinking::No);
+	TypeHandles.RemoveAtSwap(Slot.Index, 1, EAllowShrinking::No);
+	if (TypeHandles.IsValidIndex(Slot.Index))
+	{
+		// The last avatar of the type moved into the gap.
+		AvatarHandles[TypeHandles[Slot.Index]].Index = Slot.Index;
+	}
+	
 	if (LightingAvatar == InAvatar)
 	{
-		LightingAvatar = nullptr;
+		LightingAvatar = LightingAvatars.Num() > 0 ? Cast<AAetherLightingAvatar>(LightingAvatars.Last()) : nullptr;
 	}
 	else if (CloudAvatar == InAvatar)
 	{
-		CloudAvatar = nullptr;
+		CloudAvatar = CloudAvatars.Num() > 0 ? Cast<AAetherCloudAvatar>(CloudAvatars.Last()) : nullptr;
+	}
+}
+
+bool UAetherWorldSubsystem::IsAvatarRegistered(const AAetherAvatarBase* InAvatar)
+{
+	if (!InAvatar || !AvatarHandles.IsValidIndex(InAvatar->RegistrationHandle))
+	{
+		return false;
+	}
+	const FAetherAvatarSlot& Slot = AvatarHandles[InAvatar->RegistrationHandle];
+	// The handle may be left over from another world or an earlier initialization.
+	return GetAvatars(Slot.Type)[Slot.Index] == InAvatar;
+}
+
+TArray<TObjectPtr<AAetherAvatarBase>>& UAetherWorldSubsystem::GetAvatars(EAetherAvatarType Type)
+{
+	switch (Type)
+	{
+	case EAetherAvatarType::Lighting:
+		return LightingAvatars;
+	case EAetherAvatarType::Cloud:
+		return CloudAvatars;
+	case EAetherAvatarType::Puddle:
+		return PuddleAvatars;
+	default:
+		return OtherAvatars;
 	}
-	Avatars.Remove(InAvatar);
 }
 
 void UAetherWorldSubsystem::TriggerWeatherEventImmediately(const FGameplayTag& EventTag)
@@ -294,17 +621,97 @@ void UAetherWorldSubsystem::InitializeAetherSystem()
 	SystemState.Reset();
 	StreamingSourceLocation = FVector4f::Zero();
 	StreamingSourceLocation.W = -1.0f;
+	CelestialTracker.Invalidate();
+	CelestialEventSchedule.Invalidate();
+	MoonPhaseCachedDay = INDEX_NONE;
+	StreamingSources.Reset();
+	ImportAreaControllerProxies();
 	EvaluateActiveControllers();
 	UpdateSourceCoordinate();
 	if (GlobalController)
 	{
-		SystemState.ProgressOfYear = FMath::Frac(GlobalController->InitTimeStampOfYear / (GlobalController->PeriodOfDay * GlobalController->DaysOfMonth * 12));
+		SimulationClock.Initialize(
+			GlobalController->DaysOfMonth * 12,
+			GlobalController->InitTimeStampOfYear / (GlobalController->PeriodOfDay * GlobalController->DaysOfMonth * 12));
+		SystemState.ProgressOfYear = (float)SimulationClock.GetProgressOfYear();
+	}
+	InitializePlanetModel();
+	UpdateSystemState_DielRhythm(0.0f);
+	UpdateSystemStateFromActiveControllers(0.0f);
+	UpdateWorld();
+}
+
+FDelegateHandle UAetherWorldSubsystem::SubscribeCelestialEvent(EAetherCelestialEvent Event, FAetherCelestialEventSignature::FDelegate&& Delegate)
+{
+	return CelestialEventSchedule.Subscribe(Event, MoveTemp(Delegate));
+}
+
+void UAetherWorldSubsystem::AdvanceTo(int64 Year, int64 TickOfYear)
+{
+	if (!GlobalController)
+	{
+		return;
+	}
+	const int64 DeltaTicks = (Year - SimulationClock.GetYear()) * SimulationClock.GetTicksPerYear() + (TickOfYear - SimulationClock.GetTickOfYear());
+	SimulationClock.SetTime(Year, TickOfYear);
+	OnSimulationTimeJumped((double)DeltaTicks / FAetherSimulationClock::TicksPerSecond);
+}
+
+void UAetherWorldSubsystem::AdvanceBy(double SimulatedSeconds)
+{
+	if (!GlobalController)
+	{
+		return;
 	}
+	SimulationClock.Advance(SimulatedSeconds);
+	OnSimulationTimeJumped(SimulatedSeconds);
+}
+
+void UAetherWorldSubsystem::OnSimulationTimeJumped(double SimulatedSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AetherWorldSubsystem_AdvanceTime);
+	
+	SystemState.ProgressOfYear = (float)SimulationClock.GetProgressOfYear();
+	
+	// Nothing incremental survives a jump, the next solve starts from the target time.
+	CelestialTracker.Invalidate();
+	CelestialEventSchedule.Invalidate();
+	CustomBodySolver.Invalidate();
+	MoonPhaseCachedDay = INDEX_NONE;
+	
+	EvaluateActiveControllers();
+	UpdateSourceCoordinate();
 	UpdateSystemState_DielRhythm(0.0f);
+	
+	// Weather runs on game time, the day and night speed scales stretch it as when the time runs normally.
+	const float GameSeconds = (float)CalculateJumpGameSeconds(SimulatedSeconds);
+	if (GameSeconds > 0.0f)
+	{
+		for (AAetherAreaController* Controller : AreaControllers)
+		{
+			if (Controller)
+			{
+				Controller->FastForward(GameSeconds);
+			}
+		}
+		if (BackgroundController)
+		{
+			BackgroundController->FastForward(GameSeconds);
+		}
+		UpdateAreaControllerProxies(GameSeconds);
+		
+		const UAetherPluginSettings* Settings = GetDefault<UAetherPluginSettings>();
+		StormField.Advect(GameSeconds, GlobalController->StormSteeringWind, Settings->StormFadeTime, Settings->StormHashCellSize, Settings->StormHashSlack);
+	}
 	UpdateSystemStateFromActiveControllers(0.0f);
 	UpdateWorld();
 }
 
+void UAetherWorldSubsystem::UnsubscribeCelestialEvent(EAetherCelestialEvent Event, FDelegateHandle Handle)
+{
+	CelestialEventSchedule.Unsubscribe(Event, Handle);
+}
+
 void UAetherWorldSubsystem::PostWorldBeginPlay()
 {
 	// Game Word initialize once. All the actors have registered.
@@ -324,9 +731,50 @@ void UAetherWorldSubsystem::OnMapOpened(const FString& Filename, bool bAsTemplat
 
 void UAetherWorldSubsystem::EvaluateActiveControllers()
 {
-	ActiveControllers.Reset();
+	GatherStreamingSources();
 	
 	StreamingSourceLocation.W = -1.0f;
+	if (StreamingSources.Num() == 0)
+	{
+		return;
+	}
+	const FVector PrimaryLocation = StreamingSources[0].Location;
+	StreamingSourceLocation.Set(PrimaryLocation.X, PrimaryLocation.Y, PrimaryLocation.Z, 1.0f);
+	
+	UpdateShelterOccupancy();
+	
+	const bool bControllersChanged = bAreaControllerIndexDirty || bAreaControllerBoundsDirty;
+	UpdateAreaControllerIndex();
+	
+	const double CurrentTime = FPlatformTime::Seconds();
+	ParallelFor(StreamingSources.Num(), [this, bControllersChanged, CurrentTime](int32 SourceIndex)
+	{
+		EvaluateStreamingSource(StreamingSources[SourceIndex], bControllersChanged, CurrentTime);
+	}, StreamingSources.Num() < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void UAetherWorldSubsystem::GatherStreamingSources()
+{
+	for (FAetherStreamingSource& Source : StreamingSources)
+	{
+		Source.bGathered = false;
+	}
+	
+	auto GatherSource = [this](APlayerController* PlayerController, const FVector& Location)
+	{
+		FAetherStreamingSource* Source = StreamingSources.FindByPredicate([PlayerController](const FAetherStreamingSource& Existing)
+		{
+			return Existing.PlayerController.Get() == PlayerController;
+		});
+		if (!Source)
+		{
+			Source = &StreamingSources.AddDefaulted_GetRef();
+			Source->PlayerController = PlayerController;
+		}
+		Source->Location = Location;
+		Source->bGathered = true;
+	};
+	
 	if (UWorld* World = GetWorld())
 	{
 #if WITH_EDITOR
@@ -338,8 +786,7 @@ void UAetherWorldSubsystem::EvaluateActiveControllers()
 				{
 					if (const FEditorViewportClient* EditorViewportClient = static_cast<FEditorViewportClient*>(ViewportClient))
 					{
-						FVector ViewLocation = EditorViewportClient->GetViewLocation();
-						StreamingSourceLocation.Set(ViewLocation.X, ViewLocation.Y, ViewLocation.Z, 1.0f);
+						GatherSource(nullptr, EditorViewportClient->GetViewLocation());
 					}
 				}
 			}
@@ -348,19 +795,27 @@ void UAetherWorldSubsystem::EvaluateActiveControllers()
 		{
 #endif
 			check(World->IsGameWorld());
-			if (APlayerController* PlayerController = World->GetFirstPlayerController())
+			// Local players first, then the remote ones a server hosts.
+			for (int32 Pass = 0; Pass < 2; Pass++)
 			{
-				if (const AActor* ViewTarget = PlayerController->GetViewTarget())
+				for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
 				{
-					FVector ViewTargetLocation = ViewTarget->GetActorLocation();
-					StreamingSourceLocation.Set(ViewTargetLocation.X, ViewTargetLocation.Y, ViewTargetLocation.Z, 1.0f);
-				}
-				else
-				{
-					FVector ViewPointLocation;
-					FRotator Rotation;
-					PlayerController->GetPlayerViewPoint(ViewPointLocation, Rotation);
-					StreamingSourceLocation.Set(ViewPointLocation.X, ViewPointLocation.Y, ViewPointLocation.Z, 1.0f);
+					APlayerController* PlayerController = It->Get();
+					if (!PlayerController || PlayerController->IsLocalController() != (Pass == 0))
+					{
+						continue;
+					}
+					if (const AActor* ViewTarget = PlayerController->GetViewTarget())
+					{
+						GatherSource(PlayerController, ViewTarget->GetActorLocation());
+					}
+					else
+					{
+						FVector ViewPointLocation;
+						FRotator Rotation;
+						PlayerController->GetPlayerViewPoint(ViewPointLocation, Rotation);
+						GatherSource(PlayerController, ViewPointLocation);
+					}
 				}
 			}
 #if WITH_EDITOR
@@ -368,30 +823,464 @@ void UAetherWorldSubsystem::EvaluateActiveControllers()
 #endif
 	}
 	
-	if (StreamingSourceLocation.W > 0.0f)
+	StreamingSources.RemoveAll([](const FAetherStreamingSource& Source)
 	{
-		float WeightSum = 0.0f;
-		TMap<AAetherAreaController*, float> ControllerDistanceMap;
-		for (AAetherAreaController* Controller : AreaControllers)
+		return !Source.bGathered;
+	});
+	
+	// Keep the local players in front when one joins after a remote one.
+	Algo::StableSortBy(StreamingSources, [](const FAetherStreamingSource& Source)
+	{
+		const APlayerController* PlayerController = Source.PlayerController.Get();
+		return PlayerController && !PlayerController->IsLocalController();
+	});
+}
+
+void UAetherWorldSubsystem::UpdateShelterOccupancy()
+{
+	const bool bSheltersChanged = bShelterHashDirty;
+	if (bShelterHashDirty)
+	{
+		const UAetherPluginSettings* Settings = GetDefault<UAetherPluginSettings>();
+		TArray<FBox> ShelterBounds;
+		ShelterBounds.Reserve(ShelterVolumes.Num());
+		for (const AAetherShelterVolume* Shelter : ShelterVolumes)
 		{
-			if (Controller)
+			ShelterBounds.Add(Shelter ? Shelter->GetComponentsBoundingBox(true) : FBox(ForceInit));
+		}
+		ShelterHash.Build(ShelterBounds, Settings->ShelterHashCellSize);
+		bShelterHashDirty = false;
+	}
+	
+	// Point in brush tests stay on the game thread, only sources that moved test again.
+	const float RecheckDistance = GetDefault<UAetherPluginSettings>()->ShelterRecheckDistance;
+	for (FAetherStreamingSource& Source : StreamingSources)
+	{
+		if (!bSheltersChanged && !Source.bShelterDirty && FVector::DistSquared(Source.Location, Source.LastShelterLocation) < FMath::Square(RecheckDistance))
+		{
+			continue;
+		}
+		Source.bShelterDirty = false;
+		Source.LastShelterLocation = Source.Location;
+		Source.PrecipitationShelter = 0.0f;
+		Source.WindShelter = 0.0f;
+		
+		ShelterCandidates.Reset();
+		ShelterHash.QueryPoint(Source.Location, ShelterCandidates);
+		for (const int32 ShelterIndex : ShelterCandidates)
+		{
+			const AAetherShelterVolume* Shelter = ShelterVolumes[ShelterIndex];
+			if (Shelter && Shelter->EncompassesPoint(Source.Location))
 			{
-				float Dis = FVector::Distance(Controller->GetActorLocation(), FVector(StreamingSourceLocation));
-				Dis = FMath::Max(Dis - Controller->GetAffectRadius(), UE_SMALL_NUMBER);
-				float Weight = 1.0f / FMath::Pow(Dis, 2.0f);
-				ControllerDistanceMap.Add(Controller, Weight);
-				WeightSum += Weight;
+				Source.PrecipitationShelter = FMath::Max(Source.PrecipitationShelter, Shelter->GetPrecipitationShelter());
+				Source.WindShelter = FMath::Max(Source.WindShelter, Shelter->GetWindShelter());
 			}
 		}
-		for (auto It = ControllerDistanceMap.CreateConstIterator(); It; ++It)
+	}
+}
+
+void UAetherWorldSubsystem::EvaluateStreamingSource(FAetherStreamingSource& Source, bool bForce, double CurrentTime) const
+{
+	// Weights only depend on the source location and the controller bounds, keep them while neither changed meaningfully.
+	const UAetherPluginSettings* Settings = GetDefault<UAetherPluginSettings>();
+	if (!bForce && !Source.bDirty
+		&& FVector::DistSquared(Source.Location, Source.LastEvaluationLocation) < FMath::Square(Settings->ControllerEvaluationDistanceThreshold)
+		&& CurrentTime - Source.LastEvaluationTime < Settings->ControllerEvaluationMaxInterval)
+	{
+		return;
+	}
+	Source.bDirty = false;
+	Source.LastEvaluationLocation = Source.Location;
+	Source.LastEvaluationTime = CurrentTime;
+	
+	Source.ActiveControllerIndices.Reset();
+	Source.ActiveControllerWeights.Reset();
+	
+	const EAetherWeightKernel Kernel = Settings->ControllerWeightKernel;
+	Source.Candidates.Reset();
+	if (Kernel == EAetherWeightKernel::InverseSquare)
+	{
+		const double NearestDistance = AreaControllerIndex.FindNearestSurfaceDistance(Source.Location, [this, &Source](int32 RootIndex)
+		{
+			const int32 ControllerIndex = AreaControllerRoots[RootIndex];
+			return AreaControllerShapes[ControllerIndex].GetSignedDistance(Source.Location);
+		});
+		if (NearestDistance == MAX_dbl)
+		{
+			return;
+		}
+		// Weight falls with the squared surface distance, so a controller farther than the nearest one
+		// by 1 / sqrt(UE_KINDA_SMALL_NUMBER) can not pass the normalized weight threshold below.
+		const double CandidateDistance = FMath::Max(NearestDistance, (double)UE_SMALL_NUMBER) / FMath::Sqrt(UE_KINDA_SMALL_NUMBER);
+		AreaControllerIndex.QuerySphere(Source.Location, CandidateDistance, Source.Candidates);
+	}
+	else
+	{
+		AreaControllerIndex.QuerySphere(Source.Location, Settings->ControllerWeightRange, Source.Candidates);
+	}
+	
+	// Only roots are indexed, children are reached through their parent below.
+	Source.CandidateWeights.Reset();
+	for (const int32 RootIndex : Source.Candidates)
+	{
+		const int32 ControllerIndex = AreaControllerRoots[RootIndex];
+		const float Dis = (float)AreaControllerShapes[ControllerIndex].GetSignedDistance(Source.Location);
+		float Weight = EvaluateControllerWeight(Kernel, Dis, Settings->ControllerWeightRange);
+		if (Dis < 0.0f)
+		{
+			// Every kernel is flat inside the shape, keep rising with the depth so overlapping controllers still rank
+			// apart and the top-K cut below does not zero all of them.
+			Weight *= 1.0f - Dis / Settings->ControllerWeightRange;
+		}
+		if (Weight > 0.0f)
+		{
+			Source.CandidateWeights.Emplace(ControllerIndex, Weight);
+		}
+	}
+	Algo::Sort(Source.CandidateWeights, [](const TPair<int32, float>& A, const TPair<int32, float>& B)
+	{
+		return A.Value > B.Value;
+	});
+	
+	const int32 MaxActiveControllers = Settings->MaxActiveControllers;
+	if (MaxActiveControllers > 0 && Source.CandidateWeights.Num() > MaxActiveControllers)
+	{
+		// Subtract the first dropped weight, a controller swapping rank crosses the cut at zero weight.
+		const float CutWeight = Source.CandidateWeights[MaxActiveControllers].Value;
+		Source.CandidateWeights.SetNum(MaxActiveControllers, EAllowShrinking::No);
+		
+		// An exact tie with the cut, e.g. at the same depth in every shape, would leave no weight at all.
+		if (Source.CandidateWeights[0].Value > CutWeight)
+		{
+			for (TPair<int32, float>& CandidateWeight : Source.CandidateWeights)
+			{
+				CandidateWeight.Value -= CutWeight;
+			}
+		}
+	}
+	
+	float WeightSum = 0.0f;
+	for (const TPair<int32, float>& CandidateWeight : Source.CandidateWeights)
+	{
+		WeightSum += CandidateWeight.Value;
+	}
+	
+	// Inverse square is always normalized. Compact kernels only scale down, the part of the sum below 1 stays
+	// with the global controller so the blend is continuous when the source leaves the range of every controller.
+	const float Normalizer = Kernel == EAetherWeightKernel::InverseSquare ? WeightSum : FMath::Max(WeightSum, 1.0f);
+	Source.ResolvedWeights.Reset();
+	for (const TPair<int32, float>& CandidateWeight : Source.CandidateWeights)
+	{
+		DistributeControllerWeight(Source, CandidateWeight.Key, CandidateWeight.Value / Normalizer);
+	}
+	Algo::Sort(Source.ResolvedWeights, [](const TPair<int32, float>& A, const TPair<int32, float>& B)
+	{
+		return A.Value > B.Value;
+	});
+	
+	const float WeightThreshold = Kernel == EAetherWeightKernel::InverseSquare ? UE_KINDA_SMALL_NUMBER : 0.0f;
+	for (const TPair<int32, float>& ResolvedWeight : Source.ResolvedWeights)
+	{
+		if (ResolvedWeight.Value <= WeightThreshold)
+		{
+			// Sorted, the rest are lighter.
+			break;
+		}
+		Source.ActiveControllerIndices.Add(ResolvedWeight.Key);
+		Source.ActiveControllerWeights.Add(ResolvedWeight.Value);
+	}
+}
+
+void UAetherWorldSubsystem::DistributeControllerWeight(FAetherStreamingSource& Source, int32 ControllerIndex, float Weight) const
+{
+	// Children take their share of the parent by the falloff of their own shape, highest priority first.
+	// The inverse square kernel has no upper bound, children use smoothstep over the same range instead.
+	const UAetherPluginSettings* Settings = GetDefault<UAetherPluginSettings>();
+	const EAetherWeightKernel ChildKernel = Settings->ControllerWeightKernel == EAetherWeightKernel::InverseSquare ? EAetherWeightKernel::Smoothstep : Settings->ControllerWeightKernel;
+	
+	float RemainingWeight = Weight;
+	for (int32 ChildOffset = AreaControllerChildOffsets[ControllerIndex]; ChildOffset < AreaControllerChildOffsets[ControllerIndex + 1] && RemainingWeight > 0.0f; ChildOffset++)
+	{
+		const int32 ChildIndex = AreaControllerChildren[ChildOffset];
+		const float Dis = (float)AreaControllerShapes[ChildIndex].GetSignedDistance(Source.Location);
+		const float Fraction = FMath::Min(EvaluateControllerWeight(ChildKernel, Dis, Settings->ControllerWeightRange), 1.0f);
+		if (Fraction > 0.0f)
+		{
+			const float ChildWeight = RemainingWeight * Fraction;
+			DistributeControllerWeight(Source, ChildIndex, ChildWeight);
+			RemainingWeight -= ChildWeight;
+		}
+	}
+	if (RemainingWeight > 0.0f)
+	{
+		Source.ResolvedWeights.Emplace(ControllerIndex, RemainingWeight);
+	}
+}
+
+void UAetherWorldSubsystem::BlendStreamingSourceState(FAetherStreamingSource& Source) const
+{
+	Source.State = SystemState;
+	
+	// Outside of every controller the weather is the background one, with the temperature normals of the climatology at the source.
+	FAetherState Background = BackgroundController ? BackgroundController->GetCurrentState() : FAetherState();
+	const UAetherClimatologyAsset* Climatology = GlobalController ? GlobalController->Climatology.Get() : nullptr;
+	Source.bHasClimate = Climatology && Climatology->Sample(Source.Location, SystemState.ProgressOfYear, Source.Climate);
+	if (Source.bHasClimate)
+	{
+		Background.AirTemperature = Source.Climate.AirTemperature;
+	}
+	
+	TArray<const FAetherState*, TInlineAllocator<16>> States;
+	TArray<float, TInlineAllocator<16>> Weights;
+	float WeightSum = 0.0f;
+	for (int32 Index = 0; Index < Source.ActiveControllerIndices.Num(); Index++)
+	{
+		States.Add(&AreaControllerStates[Source.ActiveControllerIndices[Index]]);
+		Weights.Add(Source.ActiveControllerWeights[Index]);
+		WeightSum += Source.ActiveControllerWeights[Index];
+	}
+	States.Add(&Background);
+	Weights.Add(FMath::Max(1.0f - WeightSum, 0.0f));
+	FAetherState::BlendN(States, Weights, Source.State, EAetherStateFieldGroup::Weather);
+	
+	// Storm cells pass over the blend of the controllers, together they take at most the full weight.
+	StormField.Evaluate(Source.Location, Source.StormCandidates, Source.StormWeights);
+	if (Source.StormWeights.Num() > 0)
+	{
+		States.Reset();
+		Weights.Reset();
+		float StormWeightSum = 0.0f;
+		for (const TPair<int32, float>& StormWeight : Source.StormWeights)
+		{
+			States.Add(&StormField.GetWeather(StormWeight.Key));
+			Weights.Add(StormWeight.Value);
+			StormWeightSum += StormWeight.Value;
+		}
+		States.Add(&Source.State);
+		Weights.Add(FMath::Max(1.0f - StormWeightSum, 0.0f));
+		FAetherState::BlendN(States, Weights, Source.State, EAetherStateFieldGroup::Weather);
+	}
+	
+	Source.State.PrecipitationShelter = Source.PrecipitationShelter;
+	Source.State.WindShelter = Source.WindShelter;
+	Source.State.RainFall *= 1.0f - Source.PrecipitationShelter;
+	Source.State.SnowFall *= 1.0f - Source.PrecipitationShelter;
+	Source.State.WindData *= 1.0f - Source.WindShelter;
+}
+
+FAetherActiveControllerView UAetherWorldSubsystem::GetActiveControllers(int32 SourceIndex) const
+{
+	if (StreamingSources.IsValidIndex(SourceIndex))
+	{
+		const FAetherStreamingSource& Source = StreamingSources[SourceIndex];
+		return FAetherActiveControllerView(AreaControllers, AreaControllerProxies, Source.ActiveControllerIndices, Source.ActiveControllerWeights);
+	}
+	return FAetherActiveControllerView(AreaControllers, AreaControllerProxies, TConstArrayView<int32>(), TConstArrayView<float>());
+}
+
+void UAetherWorldSubsystem::SyncActiveControllerStates()
+{
+	// Only the controllers in a blend are read, a controller shared by several sources is copied again.
+	for (const FAetherStreamingSource& Source : StreamingSources)
+	{
+		for (const int32 ControllerIndex : Source.ActiveControllerIndices)
+		{
+			const AAetherAreaController* Controller = AreaControllers[ControllerIndex];
+			AreaControllerStates[ControllerIndex] = Controller ? Controller->GetCurrentState() : AreaControllerProxies[ControllerIndex].State;
+		}
+	}
+}
+
+float UAetherWorldSubsystem::EvaluateControllerWeight(EAetherWeightKernel Kernel, float SurfaceDistance, float Range)
+{
+	if (Kernel == EAetherWeightKernel::InverseSquare)
+	{
+		return 1.0f / FMath::Square(FMath::Max(SurfaceDistance, UE_SMALL_NUMBER));
+	}
+	
+	const float Q = FMath::Clamp(SurfaceDistance / FMath::Max(Range, 1.0f), 0.0f, 1.0f);
+	switch (Kernel)
+	{
+	case EAetherWeightKernel::Wendland:
+		return FMath::Square(FMath::Square(1.0f - Q)) * (4.0f * Q + 1.0f);
+	case EAetherWeightKernel::Smoothstep:
+		return 1.0f - Q * Q * (3.0f - 2.0f * Q);
+	case EAetherWeightKernel::Gaussian:
+		{
+			static const float Tail = FMath::Exp(-4.0f);
+			return FMath::Max((FMath::Exp(-4.0f * Q * Q) - Tail) / (1.0f - Tail), 0.0f);
+		}
+	default:
+		return 0.0f;
+	}
+}
+
+void UAetherWorldSubsystem::ImportAreaControllerProxies()
+{
+	// The editor previews the loaded controllers only, a deleted one may still have its baked proxy.
+	const UWorld* World = GetWorld();
+	if (!GlobalController || !World || !World->IsGameWorld())
+	{
+		return;
+	}
+	for (const FAetherAreaControllerProxy& Proxy : GlobalController->GetAreaControllerProxies())
+	{
+		if (Proxy.ProxyId.IsValid() && !AreaControllerSlots.Contains(Proxy.ProxyId))
 		{
-			float NormalizedWeight = It.Value() / WeightSum;
-			if (NormalizedWeight > UE_KINDA_SMALL_NUMBER)
+			AreaControllerSlots.Add(Proxy.ProxyId, AreaControllers.Add(nullptr));
+			AreaControllerProxies.Add(Proxy);
+			AreaControllerSlotHandles.Add(INDEX_NONE);
+			bAreaControllerIndexDirty = true;
+		}
+	}
+}
+
+void UAetherWorldSubsystem::UpdateAreaControllerProxies(float DeltaTime)
+{
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+	// Coarse simulation while streamed out, the weather holds and the surface water follows it in closed form.
+	for (int32 Index = 0; Index < AreaControllers.Num(); Index++)
+	{
+		if (!AreaControllers[Index])
+		{
+			FAetherAreaControllerProxy& Proxy = AreaControllerProxies[Index];
+			Proxy.SurfaceWater = AAetherAreaController::IntegrateSurfaceWater(Proxy.SurfaceWater, Proxy.State.RainFall, Proxy.EvaporationCapacity, DeltaTime);
+			AAetherAreaController::ApplySurfaceWater(Proxy.State, Proxy.SurfaceWater);
+		}
+	}
+}
+
+void UAetherWorldSubsystem::UpdateAreaControllerIndex()
+{
+	if (!bAreaControllerIndexDirty && DirtyAreaControllerSlots.Num() == 0)
+	{
+		return;
+	}
+	
+	if (bAreaControllerIndexDirty)
+	{
+		// Slots were added or removed, or the hierarchy changed.
+		AreaControllerShapes.SetNum(AreaControllers.Num());
+		AreaControllerDaytimeSpeedScales.SetNumUninitialized(AreaControllers.Num());
+		AreaControllerNightSpeedScales.SetNumUninitialized(AreaControllers.Num());
+		AreaControllerStates.SetNum(AreaControllers.Num());
+		for (int32 Index = 0; Index < AreaControllers.Num(); Index++)
+		{
+			RefreshAreaControllerSlot(Index);
+		}
+		RebuildAreaControllerHierarchy();
+	}
+	else
+	{
+		for (const int32 SlotIndex : DirtyAreaControllerSlots)
+		{
+			RefreshAreaControllerSlot(SlotIndex);
+		}
+	}
+	DirtyAreaControllerSlots.Reset();
+	
+	if (bAreaControllerIndexDirty || bAreaControllerBoundsDirty)
+	{
+		AreaControllerBounds.SetNumUninitialized(AreaControllerRoots.Num());
+		for (int32 RootIndex = 0; RootIndex < AreaControllerRoots.Num(); RootIndex++)
+		{
+			AreaControllerBounds[RootIndex] = AreaControllerShapes[AreaControllerRoots[RootIndex]].GetBounds();
+		}
+		
+		if (bAreaControllerIndexDirty)
+		{
+			AreaControllerIndex.Build(AreaControllerBounds);
+		}
+		else
+		{
+			AreaControllerIndex.Refit(AreaControllerBounds);
+		}
+	}
+	bAreaControllerIndexDirty = false;
+	bAreaControllerBoundsDirty = false;
+}
+
+void UAetherWorldSubsystem::RefreshAreaControllerSlot(int32 SlotIndex)
+{
+	// Streamed out controllers keep the shape and hierarchy of their proxy.
+	FAetherAreaControllerProxy& Proxy = AreaControllerProxies[SlotIndex];
+	if (const AAetherAreaController* Controller = AreaControllers[SlotIndex])
+	{
+		Controller->MakeProxy(Proxy);
+	}
+	Proxy.BuildInfluenceShape(AreaControllerShapes[SlotIndex]);
+	AreaControllerDaytimeSpeedScales[SlotIndex] = Proxy.DaytimeSpeedScale;
+	AreaControllerNightSpeedScales[SlotIndex] = Proxy.NightSpeedScale;
+}
+
+void UAetherWorldSubsystem::RebuildAreaControllerHierarchy()
+{
+	// A parent that is not registered, or a cycle, makes a root.
+	TArray<int32> ParentIndices;
+	ParentIndices.Init(INDEX_NONE, AreaControllers.Num());
+	for (int32 Index = 0; Index < AreaControllers.Num(); Index++)
+	{
+		const FGuid& ParentProxyId = AreaControllerProxies[Index].ParentProxyId;
+		if (const int32* ParentIndex = ParentProxyId.IsValid() ? AreaControllerSlots.Find(ParentProxyId) : nullptr)
+		{
+			ParentIndices[Index] = *ParentIndex;
+		}
+	}
+	for (int32 Index = 0; Index < AreaControllers.Num(); Index++)
+	{
+		int32 Ancestor = ParentIndices[Index];
+		for (int32 Depth = 0; Ancestor != INDEX_NONE; Depth++)
+		{
+			if (Ancestor == Index || Depth >= AreaControllers.Num())
 			{
-				ActiveControllers.Add(It.Key(), NormalizedWeight);
+				UE_LOG(LogAether, Warning, TEXT("Area controller %s is its own ancestor, treated as a root."), AreaControllers[Index] ? *AreaControllers[Index]->GetName() : *AreaControllerProxies[Index].ProxyId.ToString());
+				ParentIndices[Index] = INDEX_NONE;
+				break;
 			}
+			Ancestor = ParentIndices[Ancestor];
+		}
+	}
+	
+	AreaControllerRoots.Reset();
+	AreaControllerChildOffsets.Init(0, AreaControllers.Num() + 1);
+	for (int32 Index = 0; Index < AreaControllers.Num(); Index++)
+	{
+		if (ParentIndices[Index] == INDEX_NONE)
+		{
+			AreaControllerRoots.Add(Index);
+		}
+		else
+		{
+			AreaControllerChildOffsets[ParentIndices[Index] + 1]++;
+		}
+	}
+	for (int32 Index = 0; Index < AreaControllers.Num(); Index++)
+	{
+		AreaControllerChildOffsets[Index + 1] += AreaControllerChildOffsets[Index];
+	}
+	
+	AreaControllerChildren.SetNumUninitialized(AreaControllerChildOffsets.Last());
+	TArray<int32> ChildCounts;
+	ChildCounts.Init(0, AreaControllers.Num());
+	for (int32 Index = 0; Index < AreaControllers.Num(); Index++)
+	{
+		const int32 ParentIndex = ParentIndices[Index];
+		if (ParentIndex != INDEX_NONE)
+		{
+			AreaControllerChildren[AreaControllerChildOffsets[ParentIndex] + ChildCounts[ParentIndex]++] = Index;
 		}
 	}
+	for (int32 Index = 0; Index < AreaControllers.Num(); Index++)
+	{
+		TArrayView<int32> Children(AreaControllerChildren.GetData() + AreaControllerChildOffsets[Index], ChildCounts[Index]);
+		Algo::StableSort(Children, [this](int32 A, int32 B)
+		{
+			return AreaControllerProxies[A].Priority > AreaControllerProxies[B].Priority;
+		});
+	}
 }
 
 void UAetherWorldSubsystem::UpdateSourceCoordinate()
@@ -417,95 +1306,353 @@ void UAetherWorldSubsystem::UpdateSourceCoordinate()
 	}
 }
 
+void UAetherWorldSubsystem::InitializePlanetModel()
+{
+	UpdateSystemState_DielRhythm_Planet = &UAetherWorldSubsystem::UpdateSystemState_DielRhythm_Earth;
+	CustomBodyDirections.Reset();
+	CustomPrimarySunIndex = INDEX_NONE;
+	CustomPrimaryMoonIndex = INDEX_NONE;
+	
+	if (!GlobalController || GlobalController->SimulatePlanet != ESimulatePlanetType::CustomPlanet)
+	{
+		return;
+	}
+	
+	UpdateSystemState_DielRhythm_Planet = &UAetherWorldSubsystem::UpdateSystemState_DielRhythm_Custom;
+	
+	const TArray<FAetherCelestialBodyDescription>& Bodies = GlobalController->CelestialBodies;
+	TArray<FAetherOrbitalElements> Elements;
+	Elements.SetNum(Bodies.Num());
+	for (int32 Index = 0; Index < Bodies.Num(); Index++)
+	{
+		const FAetherCelestialBodyDescription& Body = Bodies[Index];
+		Elements[Index].SemiMajorAxis = Body.SemiMajorAxis;
+		Elements[Index].Eccentricity = Body.Eccentricity;
+		Elements[Index].Inclination = Body.Inclination;
+		Elements[Index].LongitudeOfAscendingNode = Body.LongitudeOfAscendingNode;
+		Elements[Index].ArgumentOfPeriapsis = Body.ArgumentOfPeriapsis;
+		Elements[Index].MeanAnomalyAtEpoch = Body.MeanAnomalyAtEpoch;
+		Elements[Index].OrbitalPeriod = Body.OrbitalPeriod;
+		
+		if (Body.Type == EAetherCelestialBodyType::Sun && CustomPrimarySunIndex == INDEX_NONE)
+		{
+			CustomPrimarySunIndex = Index;
+		}
+		else if (Body.Type == EAetherCelestialBodyType::Moon && CustomPrimaryMoonIndex == INDEX_NONE)
+		{
+			CustomPrimaryMoonIndex = Index;
+		}
+	}
+	CustomBodySolver.Initialize(Elements);
+	CustomBodyDirections.SetNumZeroed(Bodies.Num());
+}
+
 void UAetherWorldSubsystem::UpdateSystemState_DielRhythm(float DeltaTime)
 {
-	if (1)
+	(this->*UpdateSystemState_DielRhythm_Planet)(DeltaTime);
+}
+
+void UAetherWorldSubsystem::GetDielSpeedScales(float& OutDaytimeSpeedScale, float& OutNightSpeedScale) const
+{
+	// Weight left by the area controllers runs at the speed of the global controller.
+	float WeightSum = 0.0f;
+	float DaytimeSpeedScale = 0.0f;
+	float NightSpeedScale = 0.0f;
+	const FAetherActiveControllerView ActiveControllers = GetActiveControllers();
+	for (int32 Index = 0; Index < ActiveControllers.Num(); Index++)
+	{
+		const int32 ControllerIndex = ActiveControllers.GetControllerIndex(Index);
+		DaytimeSpeedScale += AreaControllerDaytimeSpeedScales[ControllerIndex] * ActiveControllers.GetWeight(Index);
+		NightSpeedScale += AreaControllerNightSpeedScales[ControllerIndex] * ActiveControllers.GetWeight(Index);
+		WeightSum += ActiveControllers.GetWeight(Index);
+	}
+	OutDaytimeSpeedScale = DaytimeSpeedScale + FMath::Max(1.0f - WeightSum, 0.0f);
+	OutNightSpeedScale = NightSpeedScale + FMath::Max(1.0f - WeightSum, 0.0f);
+}
+
+float UAetherWorldSubsystem::CalculateDielDeltaTime(float DeltaTime) const
+{
+	float DaytimeSpeedScale, NightSpeedScale;
+	GetDielSpeedScales(DaytimeSpeedScale, NightSpeedScale);
+	return DeltaTime * (SystemState.SunLightDirection.Z < 0.0f ? DaytimeSpeedScale : NightSpeedScale);
+}
+
+namespace AetherDaylight
+{
+	/**
+	 * Days of daylight from day 0 to Days, every day lit from Sunrise to Sunset, both in progress of day.
+	 * Sunset before sunrise is a day lit over midnight.
+	 */
+	double GetDaylightUntil(double Days, double Sunrise, double Sunset)
+	{
+		const double WholeDays = FMath::FloorToDouble(Days);
+		const double ProgressOfDay = Days - WholeDays;
+		if (Sunset >= Sunrise)
+		{
+			return WholeDays * (Sunset - Sunrise) + FMath::Clamp(ProgressOfDay - Sunrise, 0.0, Sunset - Sunrise);
+		}
+		return WholeDays * (1.0 - Sunrise + Sunset) + FMath::Min(ProgressOfDay, Sunset) + FMath::Max(ProgressOfDay - Sunrise, 0.0);
+	}
+}
+
+double UAetherWorldSubsystem::CalculateJumpGameSeconds(double SimulatedSeconds) const
+{
+	float DaytimeSpeedScale, NightSpeedScale;
+	GetDielSpeedScales(DaytimeSpeedScale, NightSpeedScale);
+	
+	// Every day of the jump takes the sunrise and sunset of the target day, they drift little from one day to the next.
+	float Sunrise = -1.0f;
+	float Sunset = -1.0f;
+	for (const FAetherCelestialEventTime& EventTime : CelestialEventSchedule.GetEventsOfDay())
+	{
+		if (EventTime.Event == EAetherCelestialEvent::Sunrise)
+		{
+			Sunrise = EventTime.ProgressOfDay;
+		}
+		else if (EventTime.Event == EAetherCelestialEvent::Sunset)
+		{
+			Sunset = EventTime.ProgressOfDay;
+		}
+	}
+	
+	const double Days = SimulatedSeconds / SECONDS_PER_DAY_EARTH;
+	const bool bSunUp = SystemState.SunLightDirection.Z < 0.0f;
+	double DaylightDays;
+	if (Sunrise >= 0.0f && Sunset >= 0.0f)
+	{
+		const double EndDays = SimulationClock.GetTotalDays();
+		DaylightDays = AetherDaylight::GetDaylightUntil(EndDays, Sunrise, Sunset) - AetherDaylight::GetDaylightUntil(EndDays - Days, Sunrise, Sunset);
+	}
+	else if (GlobalController && GlobalController->SimulatePlanet == ESimulatePlanetType::CustomPlanet)
 	{
-		UpdateSystemState_DielRhythm_Earth(DeltaTime);
+		// No schedule on a custom planet, half of every whole day is lit, the rest follows the sun at the target time.
+		const double WholeDays = FMath::FloorToDouble(Days);
+		DaylightDays = WholeDays * 0.5 + (bSunUp ? Days - WholeDays : 0.0);
 	}
 	else
 	{
-		UpdateSystemState_DielRhythm_Custom(DeltaTime);
+		// Polar day or night.
+		DaylightDays = bSunUp ? Days : 0.0;
 	}
+	
+	const double PeriodOfDay = GlobalController ? GlobalController->PeriodOfDay : SECONDS_PER_DAY_EARTH;
+	return (DaylightDays / FMath::Max(DaytimeSpeedScale, UE_KINDA_SMALL_NUMBER) + (Days - DaylightDays) / FMath::Max(NightSpeedScale, UE_KINDA_SMALL_NUMBER)) * PeriodOfDay;
+}
+
+void UAetherWorldSubsystem::AdvanceSimulationClock(float DeltaTime)
+{
+	const double SimulatedSeconds = (double)CalculateDielDeltaTime(DeltaTime) * SECONDS_PER_DAY_EARTH / GlobalController->PeriodOfDay;
+	SimulationClock.Advance(SimulatedSeconds, DeltaTime);
+	SystemState.ProgressOfYear = (float)SimulationClock.GetProgressOfYear();
+	SystemState.Time = (float)SimulationClock.GetElapsedSeconds();
 }
 
 void UAetherWorldSubsystem::UpdateSystemState_DielRhythm_Earth(float DeltaTime)
 {
 	if (GlobalController)
 	{
-		float DaytimeSpeedScale = ActiveControllers.Num() > 0 ? 0.0f : 1.0f;
-        float NightSpeedScale = ActiveControllers.Num() > 0 ? 0.0f : 1.0f;
-        for (auto It = ActiveControllers.CreateConstIterator(); It; ++It)
-        {
-        	DaytimeSpeedScale += It.Key()->DaytimeSpeedScale * It.Value();
-        	NightSpeedScale += It.Key()->NightSpeedScale * It.Value();
-        }
-        float DielDeltaTime = DeltaTime * (SystemState.SunLightDirection.Z < 0.0f ? DaytimeSpeedScale : NightSpeedScale);
-        SystemState.ProgressOfYear += DielDeltaTime / (GlobalController->PeriodOfDay * GlobalController->DaysOfMonth * 12);
-        SystemState.ProgressOfYear = FMath::Frac(SystemState.ProgressOfYear);
-        // Todo
-        SystemState.Time += DeltaTime;
+		AdvanceSimulationClock(DeltaTime);
+	}
+	UpdatePlanetByTime(DeltaTime);
+	UpdateMoonPhase();
+	
+	if (GlobalController)
+	{
+		CelestialEventSchedule.Update(SystemState.ProgressOfYear, SimulationClock.GetDaysPerYear(), SystemState.Latitude, SystemState.Longitude);
 	}
-	UpdatePlanetByTime();
 }
 
-void UAetherWorldSubsystem::UpdatePlanetByTime()
+void UAetherWorldSubsystem::UpdatePlanetByTime(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AetherWorldSubsystem_UpdatePlanet);
+	
 	if (GlobalController)
 	{
-		int32 PolarCondition = 0;
-        float SunElevation = 0.0f;
-        float SunAzimuth = 0.0f;
-        const float ProgressOfDay = FMath::Frac(SystemState.ProgressOfYear * GlobalController->DaysOfMonth * 12);
-		const float TimeStampOfEarthDay = ProgressOfDay * SECONDS_PER_DAY_EARTH;
-		const float TimeStampOfEarthYear = SystemState.ProgressOfYear * SECONDS_PER_YEAR_EARTH;
-        CalculateSunPosition(
-        	SystemState.Latitude,
-        	SystemState.Longitude,
-        	TimeStampOfEarthDay,
-        	TimeStampOfEarthYear,
-        	SunElevation,
-        	SunAzimuth,
-        	PolarCondition);
-        SystemState.SunLightDirection = ConvertPlanetLightDirection(SunElevation, SunAzimuth);
+		const float TimeStampOfEarthDay = SimulationClock.GetTimeStampOfEarthDay();
+		const float TimeStampOfEarthYear = SimulationClock.GetTimeStampOfEarthYear();
 		
-		float MoonElevation = 0.0f;
-		float MoonAzimuth = 0.0f;
-		CalculateMoonPosition(
+		// Shared by every consumer of this tick, keep it valid even when the tracker skips the solve.
+		CelestialFrame.Build(
 			SystemState.Latitude,
 			SystemState.Longitude,
 			TimeStampOfEarthDay,
 			TimeStampOfEarthYear,
-			MoonElevation,
-			MoonAzimuth);
-		SystemState.MoonLightDirection = ConvertPlanetLightDirection(MoonElevation, MoonAzimuth);
+			CVarAetherMathFastPath.GetValueOnGameThread() != 0);
+		
+		const UAetherPluginSettings* Settings = GetDefault<UAetherPluginSettings>();
+		if (Settings->bEnableCelestialTracking && CelestialTracker.Advance(
+			DeltaTime,
+			SystemState.Latitude,
+			SystemState.Longitude,
+			SimulationClock.GetProgressOfYear(),
+			SimulationClock.GetDaysPerYear(),
+			Settings->CelestialTrackingMaxAngle,
+			SystemState.SunLightDirection,
+			SystemState.MoonLightDirection))
+		{
+			return;
+		}
+		
+		int32 PolarCondition = 0;
+		FVector3f SunDirection;
+		FVector3f MoonDirection;
+		EphemerisTable.CalculatePlanetDirection(CelestialFrame, TimeStampOfEarthYear, SunDirection, PolarCondition, MoonDirection);
+		SystemState.SunLightDirection = -FVector(SunDirection);
+		SystemState.MoonLightDirection = -FVector(MoonDirection);
+		
+		if (Settings->bEnableCelestialTracking)
+		{
+			CelestialTracker.Resync(
+				SystemState.Latitude,
+				SystemState.Longitude,
+				SimulationClock.GetProgressOfYear(),
+				PolarCondition,
+				SystemState.SunLightDirection,
+				SystemState.MoonLightDirection,
+				Settings->CelestialTrackingResolveInterval,
+				Settings->CelestialTrackingErrorThreshold);
+		}
+	}
+}
+
+void UAetherWorldSubsystem::UpdateMoonPhase()
+{
+	if (!GlobalController)
+	{
+		return;
+	}
+	
+	const int32 DaysPerYear = SimulationClock.GetDaysPerYear();
+	const int32 Day = SimulationClock.GetDayOfYear();
+	
+	// The phase only drifts a few dozen degrees per simulated day, solve both ends of the day once and blend between.
+	if (Day != MoonPhaseCachedDay)
+	{
+		MoonPhaseCachedDay = Day;
+		MoonAgeAngleOfDay.X = CalculateMoonAgeAngle((float)Day / DaysPerYear * SECONDS_PER_YEAR_EARTH);
+		MoonAgeAngleOfDay.Y = CalculateMoonAgeAngle((float)(Day + 1) / DaysPerYear * SECONDS_PER_YEAR_EARTH);
+		if (MoonAgeAngleOfDay.Y < MoonAgeAngleOfDay.X)
+		{
+			MoonAgeAngleOfDay.Y += 360.0f;
+		}
 	}
+	
+	const float AgeAngle = FMath::Fmod(FMath::Lerp(MoonAgeAngleOfDay.X, MoonAgeAngleOfDay.Y, (float)SimulationClock.GetProgressOfDay()), 360.0f);
+	CalculateMoonIllumination(AgeAngle, SystemState.MoonPhaseAngle, SystemState.MoonIlluminatedFraction, SystemState.MoonIlluminance);
 }
 
 void UAetherWorldSubsystem::UpdateSystemState_DielRhythm_Custom(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AetherWorldSubsystem_UpdatePlanet);
+	
+	if (!GlobalController)
+	{
+		return;
+	}
+	
+	AdvanceSimulationClock(DeltaTime);
+	const double PlanetTime = SimulationClock.GetTotalDays();
+	
+	const bool bFastMath = CVarAetherMathFastPath.GetValueOnGameThread() != 0;
+	
+	// The reference direction of the orbital plane crosses longitude 0 at the epoch.
+	const double RotationAngle = FMath::Frac(PlanetTime / GlobalController->PlanetRotationPeriod) * UE_DOUBLE_TWO_PI;
+	CelestialFrame.BuildFromSiderealTime(
+		SystemState.Latitude,
+		(float)RotationAngle + FMath::DegreesToRadians(SystemState.Longitude),
+		GlobalController->PlanetAxialTilt,
+		bFastMath);
 	
+	CustomBodySolver.Solve(PlanetTime, bFastMath);
+	for (int32 Index = 0; Index < CustomBodyDirections.Num(); Index++)
+	{
+		CustomBodyDirections[Index] = CelestialFrame.TransformEcliptic(CustomBodySolver.GetPosition(Index).GetSafeNormal());
+	}
+	
+	if (CustomPrimarySunIndex != INDEX_NONE)
+	{
+		SystemState.SunLightDirection = -FVector(CustomBodyDirections[CustomPrimarySunIndex]);
+	}
+	if (CustomPrimaryMoonIndex != INDEX_NONE)
+	{
+		SystemState.MoonLightDirection = -FVector(CustomBodyDirections[CustomPrimaryMoonIndex]);
+		if (CustomPrimarySunIndex != INDEX_NONE)
+		{
+			// Elongation stands in for the age angle, both are 0 at new moon and 180 at full moon.
+			const float CosElongation = FVector3f::DotProduct(CustomBodyDirections[CustomPrimarySunIndex], CustomBodyDirections[CustomPrimaryMoonIndex]);
+			const float Elongation = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(CosElongation, -1.0f, 1.0f)));
+			CalculateMoonIllumination(Elongation, SystemState.MoonPhaseAngle, SystemState.MoonIlluminatedFraction, SystemState.MoonIlluminance);
+		}
+	}
 }
 
 void UAetherWorldSubsystem::UpdateSystemStateFromActiveControllers(float DeltaTime)
 {
 	EvaluateWeatherEvent(DeltaTime);
 	UpdateWeatherEvent(DeltaTime);
+	UpdateAreaControllerProxies(DeltaTime);
+	
+	if (DeltaTime > 0.0f)
+	{
+		const UAetherPluginSettings* Settings = GetDefault<UAetherPluginSettings>();
+		StormField.Advect(DeltaTime, GlobalController ? GlobalController->StormSteeringWind : FVector2D::ZeroVector, Settings->StormFadeTime, Settings->StormHashCellSize, Settings->StormHashSlack);
+	}
+	
+	SyncActiveControllerStates();
+	
+	ParallelFor(StreamingSources.Num(), [this](int32 SourceIndex)
+	{
+		BlendStreamingSourceState(StreamingSources[SourceIndex]);
+	}, StreamingSources.Num() < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	
+	// The view follows the first source, i.e. the blend of the active controllers by GetActiveControllers weights.
+	const FAetherState& ViewState = StreamingSources.Num() > 0 ? StreamingSources[0].State : FAetherState();
+	SystemState.CopyFields(ViewState, EAetherStateFieldGroup::Weather);
+	SystemState.PrecipitationShelter = ViewState.PrecipitationShelter;
+	SystemState.WindShelter = ViewState.WindShelter;
 	// Todo
 	//CalcSurfaceCoeffcient(ActualDeltaTime);
 }
 
 void UAetherWorldSubsystem::EvaluateWeatherEvent(float DeltaTime)
 {
-	if (ActiveControllers.Num() > 0)
+	UpdateBackgroundController();
+	if (BackgroundController)
 	{
-		
+		// The background weather is shared by every source, its events follow the climate at the view.
+		UAetherClimatologyAsset* Climatology = GlobalController ? GlobalController->Climatology.Get() : nullptr;
+		FAetherClimateSample Climate;
+		const bool bHasClimate = Climatology && StreamingSources.Num() > 0 && Climatology->Sample(StreamingSources[0].Location, SystemState.ProgressOfYear, Climate);
+		BackgroundController->SetClimate(Climatology, Climate, bHasClimate);
+		BackgroundController->EvaluateWeatherEvent(DeltaTime);
 	}
 }
 
 void UAetherWorldSubsystem::UpdateWeatherEvent(float DeltaTime)
 {
-	
+	if (BackgroundController)
+	{
+		BackgroundController->UpdateWeatherEvent(DeltaTime);
+	}
+}
+
+void UAetherWorldSubsystem::UpdateBackgroundController()
+{
+	UWorld* World = GetWorld();
+	const bool bNeedsBackground = World && World->IsGameWorld() && GlobalController && GlobalController->Climatology;
+	if (bNeedsBackground && !BackgroundController)
+	{
+		// Registers itself as the background controller.
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		World->SpawnActor<AAetherBackgroundController>(SpawnParameters);
+	}
+	else if (!bNeedsBackground && BackgroundController)
+	{
+		BackgroundController->Destroy();
+		BackgroundController = nullptr;
+	}
 }
 
 void UAetherWorldSubsystem::UpdateWorld()
@@ -516,11 +1663,14 @@ void UAetherWorldSubsystem::UpdateWorld()
 
 void UAetherWorldSubsystem::UpdateAvatar()
 {
-	for (AAetherAvatarBase* Avatar : Avatars)
+	for (int32 Type = 0; Type < (int32)EAetherAvatarType::Num; Type++)
 	{
-		if (Avatar)
+		for (AAetherAvatarBase* Avatar : GetAvatars((EAetherAvatarType)Type))
 		{
-			Avatar->UpdateFromSystemState(SystemState);
+			if (Avatar)
+			{
+				Avatar->UpdateFromSystemState(SystemState);
+			}
 		}
 	}
 }
@@ -553,18 +1703,29 @@ void UAetherWorldSubsystem::UpdateSystemMaterialParameter()
 		}
 	}
 	
+	// Outdoor surfaces are out of view while fully sheltered, they catch up on the way out.
+	if (SystemState.PrecipitationShelter < 1.0f)
 	{
-		float ExistValue = UKismetMaterialLibrary::GetScalarParameterValue(this, SystemMaterialParameterCollection, FName("SurfaceRainRemain"));
-		if (!FMath::IsNearlyEqual(SystemState.SurfaceRainRemain, ExistValue, UE_KINDA_SMALL_NUMBER))
 		{
-			UKismetMaterialLibrary::SetScalarParameterValue(this, SystemMaterialParameterCollection, FName("SurfaceRainRemain"), SystemState.SurfaceRainRemain);
+			float ExistValue = UKismetMaterialLibrary::GetScalarParameterValue(this, SystemMaterialParameterCollection, FName("SurfaceRainRemain"));
+			if (!FMath::IsNearlyEqual(SystemState.SurfaceRainRemain, ExistValue, UE_KINDA_SMALL_NUMBER))
+			{
+				UKismetMaterialLibrary::SetScalarParameterValue(this, SystemMaterialParameterCollection, FName("SurfaceRainRemain"), SystemState.SurfaceRainRemain);
+			}
+		}
+		{
+			float ExistValue = UKismetMaterialLibrary::GetScalarParameterValue(this, SystemMaterialParameterCollection, FName("SurfaceSnowDepth"));
+			if (!FMath::IsNearlyEqual(SystemState.SurfaceSnowDepth, ExistValue, UE_KINDA_SMALL_NUMBER))
+			{
+				UKismetMaterialLibrary::SetScalarParameterValue(this, SystemMaterialParameterCollection, FName("SurfaceSnowDepth"), SystemState.SurfaceSnowDepth);
+			}
 		}
 	}
 	{
-		float ExistValue = UKismetMaterialLibrary::GetScalarParameterValue(this, SystemMaterialParameterCollection, FName("SurfaceSnowDepth"));
-		if (!FMath::IsNearlyEqual(SystemState.SurfaceSnowDepth, ExistValue, UE_KINDA_SMALL_NUMBER))
+		float ExistValue = UKismetMaterialLibrary::GetScalarParameterValue(this, SystemMaterialParameterCollection, FName("MoonIlluminatedFraction"));
+		if (!FMath::IsNearlyEqual(SystemState.MoonIlluminatedFraction, ExistValue, UE_KINDA_SMALL_NUMBER))
 		{
-			UKismetMaterialLibrary::SetScalarParameterValue(this, SystemMaterialParameterCollection, FName("SurfaceSnowDepth"), SystemState.SurfaceSnowDepth);
+			UKismetMaterialLibrary::SetScalarParameterValue(this, SystemMaterialParameterCollection, FName("MoonIlluminatedFraction"), SystemState.MoonIlluminatedFraction);
 		}
 	}
 	{
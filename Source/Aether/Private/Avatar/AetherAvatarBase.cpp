@@ -10,6 +10,8 @@
 AAetherAvatarBase::AAetherAvatarBase()
 {
 	PrimaryActorTick.bCanEverTick = false;
+	
+	RegistrationHandle = INDEX_NONE;
 }
 
 void AAetherAvatarBase::BeginPlay()
@@ -56,6 +56,8 @@ AAetherCloudAvatar::AAetherCloudAvatar()
 	
 	RainFXComponent = CreateDefaultSubobject<UNiagaraComponent>(TEXT("RainFX"));
 	RainFXComponent->SetupAttachment(RootComponent);
+	
+	bRainFXSheltered = false;
 }
 
 void AAetherCloudAvatar::BeginPlay()
@@ -70,5 +72,15 @@ void AAetherCloudAvatar::Tick(float DeltaTime)
 
 void AAetherCloudAvatar::UpdateFromSystemState(const FAetherState& State)
 {
-	
+	const bool bSheltered = State.PrecipitationShelter >= 1.0f;
+	if (bSheltered && !bRainFXSheltered)
+	{
+		bRainFXSheltered = RainFXComponent->IsActive();
+		RainFXComponent->Deactivate();
+	}
+	else if (!bSheltered && bRainFXSheltered)
+	{
+		bRainFXSheltered = false;
+		RainFXComponent->Activate();
+	}
 }
\ No newline at end of file
@@ -41,6 +41,8 @@ AAetherLightingAvatar::AAetherLightingAvatar()
 	SkyLightComponent->SetupAttachment(RootComponent);
 	SkyLightComponent->SetRelativeLocation(FVector(0.0f, 0.0f, 100.0f));
 	
+	MoonLightIlluminanceThreshold = 0.05f;
+	
 #if WITH_EDITORONLY_DATA
 	UBillboardComponent* SpriteComponent = CreateEditorOnlyDefaultSubobject<UBillboardComponent>(TEXT("Sprite"));
 	
@@ -88,4 +90,15 @@ void AAetherLightingAvatar::Tick(float DeltaTime)
 void AAetherLightingAvatar::UpdateFromSystemState(const FAetherState& State)
 {
 	SunLightComponent->SetWorldRotation(State.SunLightDirection.Rotation());
+	MoonLightComponent->SetWorldRotation(State.MoonLightDirection.Rotation());
+	
+	// Light direction points down while the moon is above the horizon. The daytime moon is drowned by the sun,
+	// keep it from adding a second shadowed directional light.
+	const float MoonGroundIlluminance = State.MoonIlluminance * FMath::Max(-State.MoonLightDirection.Z, 0.0f);
+	const bool bMoonLightAffectsWorld = State.SunLightDirection.Z >= 0.0f && State.MoonLightDirection.Z < 0.0f && MoonGroundIlluminance >= MoonLightIlluminanceThreshold;
+	if (MoonLightComponent->bAffectsWorld != bMoonLightAffectsWorld)
+	{
+		MoonLightComponent->SetAffectsWorld(bMoonLightAffectsWorld);
+		MoonLightComponent->SetCastShadows(bMoonLightAffectsWorld);
+	}
 }
\ No newline at end of file
@@ -113,6 +113,12 @@ void AAetherPuddleAvatar_Plane::OnConstruction(const FTransform& Transform)
 
 void AAetherPuddleAvatar_Plane::UpdateFromSystemState(const FAetherState& State)
 {
+	if (State.PrecipitationShelter >= 1.0f)
+	{
+		// Out of view while fully sheltered.
+		return;
+	}
+	
 	FVector LocalLocation = WaterSurfaceMeshComponent->GetRelativeLocation();
 	float NewZ = State.PuddleRainRemain * MaxHeight + ConstantHeight;
 	if (NewZ != LocalLocation.Z)
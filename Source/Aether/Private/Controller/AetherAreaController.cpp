@@ -6,6 +6,7 @@
 #include "AetherAreaController.h"
 
 #include "Components/BillboardComponent.h"
+#include "Components/SplineComponent.h"
 
 #include "AetherStats.h"
 #include "AetherWeatherEvent.h"
@@ -52,7 +53,22 @@ AAetherAreaController::AAetherAreaController()
 	VisualizeComponent = CreateDefaultSubobject<UAetherAreaControllerVisualizeComponent>(TEXT("VisualizeComponent"));
 #endif
 	
+#if WITH_EDITORONLY_DATA
+	// Streams with its cell, the world subsystem weights the baked proxy while it is unloaded.
+	bIsSpatiallyLoaded = true;
+#endif
+	
+	InfluenceShape = EAetherInfluenceShape::Sphere;
 	AffectRadius = 1000.0f;
+	InfluenceExtent = FVector(1000.0f);
+	InfluenceConvexPoints = { FVector2D(-1000.0f, -1000.0f), FVector2D(1000.0f, -1000.0f), FVector2D(1000.0f, 1000.0f), FVector2D(-1000.0f, 1000.0f) };
+	
+	InfluenceSpline = CreateDefaultSubobject<USplineComponent>(TEXT("InfluenceSpline"));
+	InfluenceSpline->SetupAttachment(RootComponent);
+	
+	ParentController = nullptr;
+	ParentProxyId.Invalidate();
+	Priority = 0;
 	
 #if WITH_EDITORONLY_DATA
 	EarthLocationPreset = nullptr;
@@ -70,6 +86,8 @@ AAetherAreaController::AAetherAreaController()
 	InitWeatherEventTags = FGameplayTagContainer::EmptyContainer;
 	
 	SinceLastTickTime = 0.0;
+	
+	RegistrationHandle = INDEX_NONE;
 }
 
 #if WITH_EDITOR
@@ -111,6 +129,41 @@ void AAetherAreaController::PostEditChangeProperty(FPropertyChangedEvent& Proper
 	else if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, DaytimeSpeedScale) || MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, NightSpeedScale))
 	{
 		SyncOtherControllerDielRhythm();
+		if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+		{
+			Subsystem->NotifyAreaControllerDataChanged(this);
+		}
+	}
+	else if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, EvaporationCapacity))
+	{
+		if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+		{
+			Subsystem->NotifyAreaControllerDataChanged(this);
+		}
+	}
+	else if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, AffectRadius)
+		|| MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, InfluenceShape)
+		|| MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, InfluenceExtent)
+		|| MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, InfluenceConvexPoints))
+	{
+		if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+		{
+			Subsystem->NotifyAreaControllerBoundsChanged(this);
+		}
+	}
+	else if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, ParentController) || MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, Priority))
+	{
+		if (ParentController.Get() == this)
+		{
+			ParentController = nullptr;
+		}
+		// Picked in the editor, the parent is loaded.
+		const AAetherAreaController* Parent = ParentController.Get();
+		ParentProxyId = Parent ? Parent->ProxyId : FGuid();
+		if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+		{
+			Subsystem->NotifyAreaControllerHierarchyChanged(this);
+		}
 	}
 	else if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherAreaController, PossibleWeatherEvents))
 	{
@@ -129,10 +182,32 @@ bool AAetherAreaController::CanEditChange(const FProperty* InProperty) const
 }
 #endif
 
+void AAetherAreaController::PostInitProperties()
+{
+	Super::PostInitProperties();
+	
+	// Loaded controllers overwrite it, placed, duplicated and spawned ones keep it.
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		ProxyId = FGuid::NewGuid();
+	}
+}
+
 void AAetherAreaController::PostLoad()
 {
 	Super::PostLoad();
 	
+#if WITH_EDITOR
+	// Saved while the parent was a hard reference.
+	if (!ParentProxyId.IsValid() && !ParentController.IsNull())
+	{
+		if (const AAetherAreaController* Parent = ParentController.Get())
+		{
+			ParentProxyId = Parent->ProxyId;
+		}
+	}
+#endif
+	
 #if WITH_EDITORONLY_DATA
 	for (FWeatherEventDescription& Description : PossibleWeatherEvents)
 	{
@@ -141,6 +216,55 @@ void AAetherAreaController::PostLoad()
 #endif
 }
 
+void AAetherAreaController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Streamed out with its cell, Destroyed unregisters for good.
+	if (EndPlayReason == EEndPlayReason::RemovedFromWorld)
+	{
+		if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+		{
+			Subsystem->DetachAreaController(this);
+		}
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void AAetherAreaController::MakeProxy(FAetherAreaControllerProxy& OutProxy) const
+{
+	OutProxy.ProxyId = ProxyId;
+	OutProxy.ParentProxyId = ParentProxyId;
+	OutProxy.Priority = Priority;
+	OutProxy.Transform = GetActorTransform();
+	OutProxy.InfluenceShape = InfluenceShape;
+	OutProxy.AffectRadius = AffectRadius;
+	OutProxy.InfluenceExtent = InfluenceExtent;
+	OutProxy.InfluenceConvexPoints = InfluenceConvexPoints;
+	OutProxy.InfluencePolyline.Reset();
+	if (InfluenceShape == EAetherInfluenceShape::Spline && InfluenceSpline && InfluenceSpline->GetNumberOfSplinePoints() > 0)
+	{
+		// A sample every AffectRadius keeps the chord error well below the corridor width.
+		const float SplineLength = InfluenceSpline->GetSplineLength();
+		const int32 NumSegments = FMath::Clamp(FMath::CeilToInt(SplineLength / FMath::Max(AffectRadius, 100.0f)), 1, 256);
+		OutProxy.InfluencePolyline.SetNumUninitialized(NumSegments + 1);
+		for (int32 Index = 0; Index <= NumSegments; Index++)
+		{
+			OutProxy.InfluencePolyline[Index] = InfluenceSpline->GetLocationAtDistanceAlongSpline(SplineLength * Index / NumSegments, ESplineCoordinateSpace::World);
+		}
+	}
+	OutProxy.DaytimeSpeedScale = DaytimeSpeedScale;
+	OutProxy.NightSpeedScale = NightSpeedScale;
+	OutProxy.EvaporationCapacity = EvaporationCapacity;
+	OutProxy.SurfaceWater = SurfaceWater;
+	OutProxy.State = CurrentState;
+}
+
+void AAetherAreaController::ApplyProxySnapshot(const FAetherAreaControllerProxy& Proxy)
+{
+	SurfaceWater = Proxy.SurfaceWater;
+	CurrentState = Proxy.State;
+	LastState = CurrentState;
+}
+
 #if UE_ENABLE_DEBUG_DRAWING
 void AAetherAreaController::DrawDebugPointInfo(const FColor& Color) const
 {
@@ -254,7 +378,7 @@ void AAetherAreaController::EvaluateWeatherEvent(float DeltaTime)
 			// Check current running event if blocks the incoming event.
 			continue;
 		}
-		if (EventDescription.HappeningMonthsProbability.FindRef(CurrentState.Month, 0.0f) <= UE_KINDA_SMALL_NUMBER)
+		if (GetWeatherEventProbability(i) <= UE_KINDA_SMALL_NUMBER)
 		{
 			continue;
 		}
@@ -346,6 +470,11 @@ void AAetherAreaController::EvaluateWeatherEvent(float DeltaTime)
 	}
 }
 
+float AAetherAreaController::GetWeatherEventProbability(int32 Index) const
+{
+	return PossibleWeatherEvents[Index].HappeningMonthsProbability.FindRef(CurrentState.Month, 0.0f);
+}
+
 void AAetherAreaController::UpdateWeatherEvent(float DeltaTime)
 {
 	for (UAetherWeatherEventInstance* Instance : ActiveWeatherInstance)
@@ -434,6 +563,115 @@ void AAetherAreaController::UpdateWeatherEvent(float DeltaTime)
 	}
 }
 
+void AAetherAreaController::FastForward(float DeltaTime)
+{
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+	
+	LastState = CurrentState;
+	SinceLastTickTime = DeltaTime;
+	
+	FastForwardWeatherEvent(DeltaTime);
+	
+	SurfaceWater = IntegrateSurfaceWater(SurfaceWater, CurrentState.RainFall, EvaporationCapacity, DeltaTime);
+	UpdateSurfaceState();
+}
+
+void AAetherAreaController::FastForwardWeatherEvent(float DeltaTime)
+{
+	for (UAetherWeatherEventInstance* Instance : ActiveWeatherInstance)
+	{
+		if (!Instance)
+		{
+			continue;
+		}
+		check(Instance->EventClass);
+		
+		float RemainTime = DeltaTime;
+		while (RemainTime > 0.0f && Instance->State != EWeatherEventExecuteState::Finished)
+		{
+			const EWeatherEventExecuteState LastExecuteState = Instance->State;
+			if (LastExecuteState == EWeatherEventExecuteState::JustSpawned)
+			{
+				SetWeatherInstanceState(Instance, Instance->EventClass->DurationType == EWeatherEventDuration::Duration ? EWeatherEventExecuteState::BlendingIn : EWeatherEventExecuteState::Running);
+				continue;
+			}
+			if (Instance->EventClass->DurationType == EWeatherEventDuration::Instant)
+			{
+				// Same as UpdateWeatherEvent, an instant event runs once.
+				Instance->Run(0.0f, this);
+				SetWeatherInstanceState(Instance, EWeatherEventExecuteState::Finished);
+				break;
+			}
+			
+			float PhaseTime = 0.0f;
+			EWeatherEventExecuteState NextState = EWeatherEventExecuteState::Finished;
+			switch (LastExecuteState)
+			{
+				case EWeatherEventExecuteState::BlendingIn:
+					PhaseTime = Instance->BlendInTime;
+					NextState = EWeatherEventExecuteState::Running;
+					break;
+				case EWeatherEventExecuteState::Running:
+					PhaseTime = Instance->Duration;
+					NextState = EWeatherEventExecuteState::BlendingOut;
+					break;
+				case EWeatherEventExecuteState::BlendingOut:
+					PhaseTime = Instance->BlendOutTime;
+					NextState = EWeatherEventExecuteState::Finished;
+					break;
+				default:
+					check(false);
+					break;
+			}
+			
+			// The instance applies its effect once for the part of the phase the jump covers, a passed phase is completed
+			// so that its contribution is not lost, e.g. the rain a blend out takes away.
+			const float PhaseRemainTime = FMath::Max(PhaseTime - Instance->CurrentStateLastTime, 0.0f);
+			const bool bPassesPhase = RemainTime > PhaseRemainTime;
+			const float StepTime = bPassesPhase ? PhaseRemainTime : RemainTime;
+			EWeatherEventExecuteState NewState;
+			switch (LastExecuteState)
+			{
+				case EWeatherEventExecuteState::BlendingIn:
+					NewState = Instance->BlendIn(StepTime, this);
+					break;
+				case EWeatherEventExecuteState::Running:
+					NewState = Instance->Run(StepTime, this);
+					break;
+				default:
+					NewState = Instance->BlendOut(StepTime, this);
+					break;
+			}
+			RemainTime -= StepTime;
+			
+			// Same as UpdateWeatherEvent, the instance may switch the phase itself.
+			if (NewState != LastExecuteState)
+			{
+				SetWeatherInstanceState(Instance, NewState);
+			}
+			else if (bPassesPhase)
+			{
+				SetWeatherInstanceState(Instance, NextState);
+			}
+			else
+			{
+				Instance->CurrentStateLastTime += StepTime;
+			}
+		}
+	}
+	
+	for (int32 i = ActiveWeatherInstance.Num() - 1; i >= 0; i--)
+	{
+		if (ActiveWeatherInstance[i] && ActiveWeatherInstance[i]->State == EWeatherEventExecuteState::Finished)
+		{
+			ActiveWeatherInstance.RemoveAt(i);
+		}
+	}
+}
+
 void AAetherAreaController::TriggerWeatherEventImmediately(const FGameplayTag& EventTag)
 {
 	
@@ -542,9 +780,31 @@ void AAetherAreaController::CalcSurfaceCoeffcient(float DeltaTime)
 		SurfaceWater -= EvaporationCapacity * DeltaTime;
 		SurfaceWater = FMath::Max(SurfaceWater, 0.0f);
 	}
-	CurrentState.TestValue = SurfaceWater;
-	CurrentState.SurfaceRainRemain = FMath::Clamp(SurfaceWater / 100.0f, 0.0f, 1.0f);
-	CurrentState.PuddleRainRemain = CurrentState.SurfaceRainRemain;
+	UpdateSurfaceState();
+}
+
+void AAetherAreaController::UpdateSurfaceState()
+{
+	ApplySurfaceWater(CurrentState, SurfaceWater);
+}
+
+float AAetherAreaController::IntegrateSurfaceWater(float SurfaceWater, float RainFall, float EvaporationCapacity, float DeltaTime)
+{
+	// The rain fall is taken as constant over the jump. Below the cap the water changes linearly with rain minus evaporation,
+	// above it the stepped update only evaporates, so it settles on the cap.
+	const float NetRate = RainFall - EvaporationCapacity;
+	if (NetRate > 0.0f)
+	{
+		return FMath::Min(SurfaceWater + NetRate * DeltaTime, FMath::Max(SurfaceWater, 1000.0f));
+	}
+	return FMath::Max(SurfaceWater + NetRate * DeltaTime, 0.0f);
+}
+
+void AAetherAreaController::ApplySurfaceWater(FAetherState& State, float SurfaceWater)
+{
+	State.TestValue = SurfaceWater;
+	State.SurfaceRainRemain = FMath::Clamp(SurfaceWater / 100.0f, 0.0f, 1.0f);
+	State.PuddleRainRemain = State.SurfaceRainRemain;
 }
 
 #if WITH_EDITOR
@@ -0,0 +1,62 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherBackgroundController.h"
+
+#include "AetherPluginSettings.h"
+#include "AetherWeatherEvent.h"
+
+AAetherBackgroundController::AAetherBackgroundController()
+{
+#if WITH_EDITORONLY_DATA
+	bIsSpatiallyLoaded = false;
+#endif
+	
+	Climatology = nullptr;
+	bHasClimate = false;
+}
+
+void AAetherBackgroundController::SetClimate(UAetherClimatologyAsset* InClimatology, const FAetherClimateSample& InClimate, bool bInHasClimate)
+{
+	if (Climatology != InClimatology)
+	{
+		// One description per event, in the order of the probability channels.
+		Climatology = InClimatology;
+		PossibleWeatherEvents.Reset();
+		if (Climatology)
+		{
+			for (UAetherWeatherEvent* Event : Climatology->GetEvents())
+			{
+				FWeatherEventDescription& Description = PossibleWeatherEvents.AddDefaulted_GetRef();
+				Description.Event = Event;
+				Description.TriggerSource = EWeatherTriggerSource::AetherController;
+			}
+		}
+	}
+	
+	Climate = InClimate;
+	bHasClimate = bInHasClimate;
+	if (bHasClimate)
+	{
+		// Weather events read it, e.g. rain blends out when it freezes.
+		CurrentState.AirTemperature = Climate.AirTemperature;
+	}
+}
+
+float AAetherBackgroundController::GetWeatherEventProbability(int32 Index) const
+{
+	if (!bHasClimate || !Climate.EventProbabilities.IsValidIndex(Index))
+	{
+		return 0.0f;
+	}
+	// A month below the dry precipitation normal gets no rain or snow, whatever the event channel says.
+	const UAetherWeatherEvent* Event = PossibleWeatherEvents[Index].Event;
+	const bool bPrecipitation = Event && (Event->EventType == EWeatherEventType::Rainy || Event->EventType == EWeatherEventType::Snowy);
+	if (bPrecipitation && Climate.Precipitation < GetDefault<UAetherPluginSettings>()->ClimateDryPrecipitation)
+	{
+		return 0.0f;
+	}
+	return Climate.EventProbabilities[Index];
+}
\ No newline at end of file
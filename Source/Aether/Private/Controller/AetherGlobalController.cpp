@@ -6,7 +6,14 @@
 #include "AetherGlobalController.h"
 
 #include "Components/BillboardComponent.h"
+#include "EngineUtils.h"
+#if WITH_EDITOR
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDescInstance.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#endif
 
+#include "AetherAreaController.h"
 #include "AetherWorldSubsystem.h"
 
 AAetherGlobalController::AAetherGlobalController()
@@ -62,6 +69,10 @@ AAetherGlobalController::AAetherGlobalController()
 	DaysOfMonth = 8;
 	NorthDirectionYawOffset = 0.0f;
 	InitTimeStampOfYear = 0.0f;
+	PlanetAxialTilt = 23.44f;
+	PlanetRotationPeriod = 0.99727f;
+	Climatology = nullptr;
+	StormSteeringWind = FVector2D::ZeroVector;
 }
 
 #if WITH_EDITOR
@@ -97,6 +108,15 @@ void AAetherGlobalController::PostEditChangeProperty(FPropertyChangedEvent& Prop
 		InitTimeStampOfYear = FMath::Max(InitTimeStampOfYear, 0.0f);
 		InitTimeStampOfYear = FMath::Fmod(InitTimeStampOfYear, PeriodOfDay * DaysOfMonth * 12);
 	}
+	else if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherGlobalController, SimulatePlanet)
+		|| MemberPropertyName == GET_MEMBER_NAME_CHECKED(AAetherGlobalController, CelestialBodies))
+	{
+		// The planet model and the orbits are only picked up on initialization.
+		if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
+		{
+			Subsystem->InitializeAetherSystem();
+		}
+	}
 }
 
 bool AAetherGlobalController::CanEditChange(const FProperty* InProperty) const
@@ -109,6 +129,52 @@ void AAetherGlobalController::CaptureTimeStamp()
 {
 	if (UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(this))
 	{
-		InitTimeStampOfYear = Subsystem->GetSystemState().ProgressOfYear * (PeriodOfDay * DaysOfMonth * 12);
+		InitTimeStampOfYear = Subsystem->GetSimulationClock().GetProgressOfYear() * (PeriodOfDay * DaysOfMonth * 12);
+	}
+}
+
+#if WITH_EDITOR
+void AAetherGlobalController::BakeAreaControllerProxies()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+	
+	TArray<FAetherAreaControllerProxy> Proxies;
+	auto AddProxy = [&Proxies](const AAetherAreaController* Controller)
+	{
+		if (Controller && Controller->GetProxyId().IsValid())
+		{
+			Controller->MakeProxy(Proxies.AddDefaulted_GetRef());
+		}
+	};
+	if (UWorldPartition* WorldPartition = World->GetWorldPartition())
+	{
+		// Walks the actor descriptors, so controllers of unloaded cells are seen and deleted ones are not.
+		FWorldPartitionHelpers::FForEachActorWithLoadingParams Params;
+		Params.ActorClasses = { AAetherAreaController::StaticClass() };
+		FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, [&AddProxy](const FWorldPartitionActorDescInstance* ActorDescInstance)
+		{
+			AddProxy(Cast<AAetherAreaController>(ActorDescInstance->GetActor()));
+			return true;
+		}, Params);
 	}
-}
\ No newline at end of file
+	else
+	{
+		for (TActorIterator<AAetherAreaController> It(World); It; ++It)
+		{
+			AddProxy(*It);
+		}
+	}
+	
+	// Stable order, baking an unchanged world does not dirty the actor.
+	Proxies.Sort([](const FAetherAreaControllerProxy& A, const FAetherAreaControllerProxy& B)
+	{
+		return A.ProxyId < B.ProxyId;
+	});
+	Modify();
+	AreaControllerProxies = MoveTemp(Proxies);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AetherTypes.h"
+
+/**
+ * @param Event The event reached.
+ * @param ProgressOfYear Simulated time the event solved at, may be slightly before the current time.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FAetherCelestialEventSignature, EAetherCelestialEvent /*Event*/, float /*ProgressOfYear*/);
+
+struct FAetherCelestialEventTime
+{
+	EAetherCelestialEvent Event;
+	
+	float ProgressOfDay;
+};
+
+/**
+ * Sunrise, sunset, twilight, moonrise and moonset times of the current simulated day at the current coordinate.
+ * Solved once per simulated day or when the coordinate moves, subscribers are called once when the simulated time crosses an event.
+ */
+struct AETHER_API FAetherCelestialEventSchedule
+{
+public:
+	FAetherCelestialEventSchedule();
+	
+	/**
+	 * Drop the cached day, the next Update rebuilds without firing events already passed.
+	 * Subscribers are kept.
+	 */
+	void Invalidate();
+	
+	void Update(float ProgressOfYear, int32 DaysPerYear, float Latitude, float Longitude);
+	
+	FDelegateHandle Subscribe(EAetherCelestialEvent Event, FAetherCelestialEventSignature::FDelegate&& Delegate);
+	void Unsubscribe(EAetherCelestialEvent Event, FDelegateHandle Handle);
+	
+	/**
+	 * Only searches the current simulated day.
+	 * @return false if the event does not happen again today.
+	 */
+	bool GetNextEventTime(EAetherCelestialEvent Event, float& OutProgressOfYear) const;
+	
+	/**
+	 * Sorted by time.
+	 */
+	FORCEINLINE const TArray<FAetherCelestialEventTime>& GetEventsOfDay() const { return Events; }
+	
+private:
+	void BuildDay(int32 Day, int32 DaysPerYear, float Latitude, float Longitude);
+	
+	int32 FindFirstEventAfter(float ProgressOfDay) const;
+	
+	void BroadcastUntil(float ProgressOfDay);
+	
+private:
+	TArray<FAetherCelestialEventTime> Events;
+	
+	int32 CachedDay;
+	int32 CachedDaysPerYear;
+	float CachedLatitude;
+	float CachedLongitude;
+	
+	int32 NextEventIndex;
+	float LastProgressOfDay;
+	
+	FAetherCelestialEventSignature Delegates[(int32)EAetherCelestialEvent::MAX];
+};
\ No newline at end of file
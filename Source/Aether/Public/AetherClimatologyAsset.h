@@ -0,0 +1,101 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Math/Float16.h"
+#include "Serialization/BulkData.h"
+
+#include "AetherClimatologyAsset.generated.h"
+
+/**
+ * Climate normals at a location, interpolated between the surrounding cells and the surrounding months.
+ */
+struct AETHER_API FAetherClimateSample
+{
+	FAetherClimateSample();
+	
+	// Celsius.
+	float AirTemperature;
+	
+	// Millimeter per month.
+	float Precipitation;
+	
+	// Same order as UAetherClimatologyAsset::GetEvents.
+	TArray<float, TInlineAllocator<8>> EventProbabilities;
+};
+
+/**
+ * Monthly climate normals over a grid on the world XY plane, the background climate where no area controller is placed.
+ * Values are cell centered and kept as bulk data outside the export, memory mapped where the platform supports it.
+ */
+UCLASS(MinimalAPI)
+class UAetherClimatologyAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+	
+protected:
+	/**
+	 * World XY of the corner of cell (0, 0).
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Aether|Climatology")
+	FVector2D Origin;
+	
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Aether|Climatology", meta = (ForceUnits = "cm"))
+	float CellSize;
+	
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Aether|Climatology")
+	FIntPoint GridSize;
+	
+	/**
+	 * Weather events with a probability channel.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Aether|Climatology")
+	TArray<TObjectPtr<class UAetherWeatherEvent>> Events;
+	
+	/**
+	 * Half floats, ((Y * GridSize.X + X) * 12 + Month) * GetNumChannels() + Channel.
+	 * Channel 0 is the air temperature, 1 the precipitation, the event probabilities follow.
+	 */
+	FByteBulkData CellData;
+	
+	// CellData stays read locked while this is set, null until loaded or when the payload does not match the grid.
+	const FFloat16* CellValues;
+	
+public:
+	AETHER_API UAetherClimatologyAsset();
+	
+	//~ Begin UObject Interface
+	AETHER_API virtual void Serialize(FArchive& Ar) override;
+	AETHER_API virtual void PostLoad() override;
+	AETHER_API virtual void BeginDestroy() override;
+	//~ End UObject Interface
+	
+	/**
+	 * Thread safe. False outside the grid.
+	 */
+	AETHER_API bool Sample(const FVector& Location, float ProgressOfYear, FAetherClimateSample& OutSample) const;
+	
+#if WITH_EDITOR
+	/**
+	 * Replace the grid, Values in the layout of CellData, as floats.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Aether|Climatology")
+	AETHER_API void Build(FVector2D InOrigin, float InCellSize, FIntPoint InGridSize, const TArray<UAetherWeatherEvent*>& InEvents, const TArray<float>& Values);
+#endif
+	
+	FORCEINLINE int32 GetNumChannels() const { return 2 + Events.Num(); }
+	FORCEINLINE const TArray<TObjectPtr<UAetherWeatherEvent>>& GetEvents() const { return Events; }
+	
+	FORCEINLINE bool HasCellData() const { return CellValues != nullptr; }
+	
+private:
+	void MapCellData();
+	void UnmapCellData();
+	
+	int64 GetNumValues() const;
+};
\ No newline at end of file
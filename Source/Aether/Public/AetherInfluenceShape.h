@@ -0,0 +1,68 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AetherTypes.h"
+
+/**
+ * World space influence volume of an area controller, built on the game thread and read by any thread.
+ */
+struct AETHER_API FAetherInfluenceShape
+{
+public:
+	FAetherInfluenceShape();
+	
+	void SetSphere(const FVector& InCenter, float InRadius);
+	
+	/**
+	 * Oriented box of half size InExtent, the scale of InTransform is ignored.
+	 */
+	void SetBox(const FTransform& InTransform, const FVector& InExtent);
+	
+	/**
+	 * Convex hull of InPoints in the local XY plane, extruded by InHalfHeight along local Z.
+	 */
+	void SetConvex(const FTransform& InTransform, TConstArrayView<FVector2D> InPoints, float InHalfHeight);
+	
+	/**
+	 * Corridor of InRadius around a polyline sampled from a spline.
+	 */
+	void SetCorridor(TConstArrayView<FVector> InPolyline, float InRadius);
+	
+	/**
+	 * Negative inside. Exact for sphere, box and corridor, the convex prism is exact up to its top and bottom edges.
+	 */
+	double GetSignedDistance(const FVector& Point) const;
+	
+	FORCEINLINE const FBox& GetBounds() const { return Bounds; }
+	FORCEINLINE EAetherInfluenceShape GetType() const { return Type; }
+	
+	// Local XY, counter clockwise.
+	FORCEINLINE const TArray<FVector2D>& GetConvexHull() const { return ConvexHull; }
+	
+	static void ComputeConvexHull(TConstArrayView<FVector2D> InPoints, TArray<FVector2D>& OutHull);
+	
+private:
+	EAetherInfluenceShape Type;
+	
+	// Rotation and translation only.
+	FTransform Transform;
+	
+	// Box half size, Z is the half height of the convex prism.
+	FVector Extent;
+	
+	// Sphere and corridor.
+	float Radius;
+	
+	TArray<FVector2D> ConvexHull;
+	
+	// World space.
+	TArray<FVector> Polyline;
+	
+	FBox Bounds;
+};
\ No newline at end of file
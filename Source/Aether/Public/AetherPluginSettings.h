@@ -8,6 +8,8 @@
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
 
+#include "AetherTypes.h"
+
 #include "AetherPluginSettings.generated.h"
 
 UCLASS(config = Engine, defaultconfig, meta = (DisplayName = "Aether"))
@@ -22,6 +24,103 @@ public:
 	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether")
 	float SystemTickMinInterval;
 	
+	/**
+	 * Weight of an area controller by the distance from the streaming source to its AffectRadius.
+	 * Compact kernels are 1 at AffectRadius and reach exactly zero at ControllerWeightRange outside it,
+	 * the part of the total weight below 1 is left to the global controller.
+	 * Inside the shape every kernel keeps rising by the depth over ControllerWeightRange, so overlapping controllers rank apart.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Area Controller")
+	EAetherWeightKernel ControllerWeightKernel;
+	
+	/**
+	 * Centimeter. Distance outside AffectRadius where a compact kernel reaches zero.
+	 * Every kernel, inverse square included, also uses it for the depth ranking inside a shape and for the smoothstep falloff of children.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Area Controller", meta = (ClampMin = "1.0"))
+	float ControllerWeightRange;
+	
+	/**
+	 * Keep only the K heaviest area controllers, 0 keeps all. The (K + 1)th weight is subtracted from the kept ones
+	 * so that a controller entering or leaving the set does it at zero weight.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Area Controller", meta = (ClampMin = "0"))
+	int32 MaxActiveControllers;
+	
+	/**
+	 * Centimeter. The streaming source moves at least this far before the active area controllers are evaluated again.
+	 * Adding, moving or removing a controller always evaluates again.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Area Controller", meta = (ClampMin = "0.0"))
+	float ControllerEvaluationDistanceThreshold;
+	
+	/**
+	 * Second. Upper bound of the real time between two evaluations of the active area controllers.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Area Controller", meta = (ClampMin = "0.0"))
+	float ControllerEvaluationMaxInterval;
+	
+	/**
+	 * Centimeter. The streaming source moves at least this far before its shelter volumes are tested again.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Shelter", meta = (ClampMin = "0.0"))
+	float ShelterRecheckDistance;
+	
+	/**
+	 * Centimeter. Cell size of the spatial hash over shelter volumes, about the size of a building.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Shelter", meta = (ClampMin = "100.0"))
+	float ShelterHashCellSize;
+	
+	/**
+	 * Centimeter. Cell size of the spatial hash over storm cells, about the radius of a storm.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Storm", meta = (ClampMin = "100.0"))
+	float StormHashCellSize;
+	
+	/**
+	 * Centimeter. Storm cells are hashed this much larger than they are, the hash is rebuilt once a cell drifted farther.
+	 * Larger rebuilds less often but returns more candidates to every streaming source.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Storm", meta = (ClampMin = "0.0"))
+	float StormHashSlack;
+	
+	/**
+	 * Second. A storm cell with a lifetime fades out over its last seconds.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Storm", meta = (ClampMin = "0.0"))
+	float StormFadeTime;
+	
+	/**
+	 * Millimeter per month. Below this precipitation normal the climatology triggers no rain or snow event.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Climatology", meta = (ClampMin = "0.0"))
+	float ClimateDryPrecipitation;
+	
+	/**
+	 * Advance the sun and moon by rotating around the celestial pole between full ephemeris solves.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Celestial Tracking")
+	bool bEnableCelestialTracking;
+	
+	/**
+	 * Second. Upper bound of the time between two full solves, shortened automatically while the measured drift is above the threshold.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Celestial Tracking", meta = (EditCondition = "bEnableCelestialTracking", ClampMin = "0.05"))
+	float CelestialTrackingResolveInterval;
+	
+	/**
+	 * Degree. Accumulated rotation of the faster of sun and moon after which a full solve is forced, a single step above this is treated as a time jump.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Celestial Tracking", meta = (EditCondition = "bEnableCelestialTracking", ClampMin = "0.1"))
+	float CelestialTrackingMaxAngle;
+	
+	/**
+	 * Degree. Drift tolerated between tracked and solved direction.
+	 */
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Aether|Celestial Tracking", meta = (EditCondition = "bEnableCelestialTracking", ClampMin = "0.0"))
+	float CelestialTrackingErrorThreshold;
+	
 public:
 	UAetherPluginSettings();
 	
@@ -0,0 +1,53 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Volume.h"
+
+#include "AetherShelterVolume.generated.h"
+
+/**
+ * Interior or covered space, masks precipitation and wind for streaming sources inside it.
+ */
+UCLASS()
+class AETHER_API AAetherShelterVolume : public AVolume
+{
+	GENERATED_BODY()
+	
+protected:
+	/**
+	 * 1 stops rain and snow completely, e.g. a room. Lower for a porch or a tree canopy.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Shelter", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float PrecipitationShelter;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Shelter", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float WindShelter;
+	
+public:
+	AAetherShelterVolume();
+	
+	//~ Begin AActor Interface
+	virtual void PostInitializeComponents() override;
+	
+	virtual void OnConstruction(const FTransform& Transform) override;
+	
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
+	virtual void Destroyed() override;
+	
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	
+	virtual void PostEditMove(bool bFinished) override;
+#endif
+	//~ End AActor Interface
+	
+public:
+	FORCEINLINE float GetPrecipitationShelter() const { return PrecipitationShelter; }
+	FORCEINLINE float GetWindShelter() const { return WindShelter; }
+};
\ No newline at end of file
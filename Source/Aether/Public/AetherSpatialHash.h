@@ -0,0 +1,45 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid over the XY plane for point queries against item bounds, items are referred to by their index in the array given to Build.
+ * Suits many small items that rarely move, rebuild when any of them changes.
+ */
+struct AETHER_API FAetherSpatialHash
+{
+public:
+	FAetherSpatialHash();
+	
+	void Build(TConstArrayView<FBox> InItems, double InCellSize);
+	
+	void Reset();
+	
+	/**
+	 * Every item whose bounds contain Point.
+	 */
+	void QueryPoint(const FVector& Point, TArray<int32>& OutItems) const;
+	
+	FORCEINLINE int32 Num() const { return Items.Num(); }
+	
+	/**
+	 * Items covering more cells than this are kept in a list tested by every query.
+	 */
+	static constexpr int32 MaxCellsPerItem = 256;
+	
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+	
+	double CellSize;
+	
+	TMap<FIntPoint, TArray<int32>> Cells;
+	
+	TArray<int32> OversizedItems;
+	
+	TArray<FBox> Items;
+};
\ No newline at end of file
@@ -0,0 +1,64 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bounding volume hierarchy over item bounds, items are referred to by their index in the array given to Build.
+ * Build when items are added or removed, Refit when they only move or resize.
+ * The exact shape of an item is only known through a signed distance callback, its bounds must contain it.
+ */
+struct AETHER_API FAetherSpatialIndex
+{
+public:
+	typedef TFunctionRef<double(int32 Item)> FSignedDistanceFunction;
+	
+	void Build(TConstArrayView<FBox> InItems);
+	
+	/**
+	 * Same item count and order as the last Build.
+	 */
+	void Refit(TConstArrayView<FBox> InItems);
+	
+	void Reset();
+	
+	/**
+	 * Smallest signed distance from Point to any item, negative inside. MAX_dbl when empty.
+	 */
+	double FindNearestSurfaceDistance(const FVector& Point, FSignedDistanceFunction SignedDistance) const;
+	
+	/**
+	 * Every item whose bounds are within Radius of Point, the exact distance is left to the caller.
+	 */
+	void QuerySphere(const FVector& Point, double Radius, TArray<int32>& OutItems) const;
+	
+	FORCEINLINE int32 Num() const { return Items.Num(); }
+	
+	/**
+	 * Items per leaf.
+	 */
+	static constexpr int32 LeafSize = 4;
+	
+private:
+	struct FNode
+	{
+		FBox Bounds;
+		
+		// Leaf: first entry in ItemOrder. Internal: first of the two consecutive children.
+		int32 First;
+		
+		// Items in a leaf, 0 for an internal node.
+		int32 Count;
+	};
+	
+	// Children are always stored after their parent, a reverse walk visits children first.
+	TArray<FNode> Nodes;
+	
+	TArray<int32> ItemOrder;
+	
+	TArray<FBox> Items;
+};
\ No newline at end of file
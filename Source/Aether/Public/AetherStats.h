@@ -10,4 +10,6 @@
 DECLARE_STATS_GROUP(TEXT("AetherTickGroup"), STATGROUP_Aether, STATCAT_Advanced)
 
 DECLARE_CYCLE_STAT(TEXT("AetherWorldSubsystem_Tick"), STAT_AetherWorldSubsystem_Tick, STATGROUP_Aether);
+DECLARE_CYCLE_STAT(TEXT("AetherWorldSubsystem_UpdatePlanet"), STAT_AetherWorldSubsystem_UpdatePlanet, STATGROUP_Aether);
+DECLARE_CYCLE_STAT(TEXT("AetherWorldSubsystem_AdvanceTime"), STAT_AetherWorldSubsystem_AdvanceTime, STATGROUP_Aether);
 DECLARE_CYCLE_STAT(TEXT("AetherController_Tick"), STAT_AetherController_Tick, STATGROUP_Aether);
\ No newline at end of file
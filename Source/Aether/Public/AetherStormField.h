@@ -0,0 +1,80 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AetherSpatialHash.h"
+#include "AetherTypes.h"
+
+/**
+ * Storm cells moving over the XY plane, densely packed by field and looked up through a spatial hash.
+ * The hash holds every cell grown by a slack, it is only rebuilt once a cell drifted farther than that from where it was hashed.
+ * A cell keeps its id for its whole life, its dense index changes when another cell is removed.
+ */
+struct AETHER_API FAetherStormField
+{
+public:
+	FAetherStormField();
+	
+	int32 Add(const FAetherStormCellDescription& Description);
+	
+	void Remove(int32 CellId);
+	
+	void Reset();
+	
+	/**
+	 * Move every cell by its velocity and Wind and remove the expired ones.
+	 * The lookup is rebuilt when a cell left its slack, a cell was removed or the hash parameters changed.
+	 */
+	void Advect(float DeltaTime, const FVector2D& Wind, float FadeTime, double HashCellSize, double HashSlack);
+	
+	/**
+	 * Thread safe. Dense index and weight of every cell over Location, Candidates is scratch.
+	 */
+	void Evaluate(const FVector& Location, TArray<int32>& Candidates, TArray<TPair<int32, float>>& OutWeights) const;
+	
+	FORCEINLINE int32 Num() const { return Locations.Num(); }
+	FORCEINLINE bool IsValidId(int32 CellId) const { return IdToIndex.IsValidIndex(CellId); }
+	
+	FORCEINLINE int32 GetId(int32 Index) const { return IndexToId[Index]; }
+	FORCEINLINE const FVector& GetLocation(int32 Index) const { return Locations[Index]; }
+	FORCEINLINE float GetRadius(int32 Index) const { return Radii[Index]; }
+	FORCEINLINE const FAetherState& GetWeather(int32 Index) const { return Weathers[Index]; }
+	
+private:
+	void RemoveAtIndex(int32 Index);
+	
+	void BuildHash();
+	
+	// Advected every tick.
+	TArray<FVector> Locations;
+	TArray<FVector> Velocities;
+	TArray<float> Radii;
+	TArray<float> Intensities;
+	
+	// Negative lives until removed.
+	TArray<float> RemainingLifetimes;
+	
+	// Intensity with the fade out applied, the weight at the center.
+	TArray<float> Strengths;
+	
+	// Read for the cells over a streaming source only.
+	TArray<FAetherState> Weathers;
+	
+	TArray<int32> IndexToId;
+	TSparseArray<int32> IdToIndex;
+	
+	FAetherSpatialHash Hash;
+	double HashCellSize;
+	double HashSlack;
+	
+	// Locations of the cells when the hash was built, by dense index.
+	TArray<FVector> HashedLocations;
+	
+	// Cache for calculation.
+	TArray<FBox> Bounds;
+};
\ No newline at end of file
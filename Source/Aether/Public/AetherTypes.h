@@ -15,7 +15,7 @@ UENUM(BlueprintType)
 enum class ESimulatePlanetType : uint8
 {
 	Earth			UMETA(DisplayName = "Earth"),
-	CustomPlanet	UMETA(Hidden),
+	CustomPlanet	UMETA(DisplayName = "Custom Planet"),
 };
 
 UENUM(BlueprintType)
@@ -95,6 +95,172 @@ enum class EWeatherEventDuration : uint8
 	Duration	UMETA(DisplayName = "Duration"),
 };
 
+UENUM(BlueprintType)
+enum class EAetherCelestialEvent : uint8
+{
+	AstronomicalDawn	UMETA(DisplayName = "Astronomical Dawn"),
+	NauticalDawn		UMETA(DisplayName = "Nautical Dawn"),
+	CivilDawn			UMETA(DisplayName = "Civil Dawn"),
+	Sunrise				UMETA(DisplayName = "Sunrise"),
+	Sunset				UMETA(DisplayName = "Sunset"),
+	CivilDusk			UMETA(DisplayName = "Civil Dusk"),
+	NauticalDusk		UMETA(DisplayName = "Nautical Dusk"),
+	AstronomicalDusk	UMETA(DisplayName = "Astronomical Dusk"),
+	Moonrise			UMETA(DisplayName = "Moonrise"),
+	Moonset				UMETA(DisplayName = "Moonset"),
+	MAX					UMETA(Hidden),
+};
+
+UENUM(BlueprintType)
+enum class EAetherWeightKernel : uint8
+{
+	/**
+	 * 1 / SurfaceDistance^2 normalized over every area controller, never reaches zero.
+	 */
+	InverseSquare	UMETA(DisplayName = "Inverse Square"),
+	/**
+	 * Wendland C2, (1 - q)^4 * (4q + 1).
+	 */
+	Wendland		UMETA(DisplayName = "Wendland"),
+	/**
+	 * 1 - smoothstep(q).
+	 */
+	Smoothstep		UMETA(DisplayName = "Smoothstep"),
+	/**
+	 * exp(-4q^2), shifted down to reach zero at the range.
+	 */
+	Gaussian		UMETA(DisplayName = "Gaussian"),
+};
+
+UENUM(BlueprintType)
+enum class EAetherInfluenceShape : uint8
+{
+	Sphere			UMETA(DisplayName = "Sphere"),
+	Box				UMETA(DisplayName = "Box"),
+	/**
+	 * Convex hull of points in the local XY plane, extruded along local Z.
+	 */
+	Convex			UMETA(DisplayName = "Convex"),
+	/**
+	 * Corridor along a spline.
+	 */
+	Spline			UMETA(DisplayName = "Spline"),
+};
+
+UENUM(BlueprintType)
+enum class EAetherCelestialBodyType : uint8
+{
+	Sun				UMETA(DisplayName = "Sun"),
+	Moon			UMETA(DisplayName = "Moon"),
+};
+
+/**
+ * A body in the sky of a custom planet, on a Keplerian orbit around the planet.
+ * Reference plane is the orbital plane of the planet. A sun is the orbit of the planet seen from the planet,
+ * i.e. the planet elements with the argument of periapsis turned by 180 degrees.
+ */
+USTRUCT(BlueprintType)
+struct AETHER_API FAetherCelestialBodyDescription
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Name;
+	
+	/**
+	 * The first sun drives SunLightDirection, the first moon drives MoonLightDirection and the moon phase.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EAetherCelestialBodyType Type;
+	
+	/**
+	 * Any unit, only the ratio between the bodies matters.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float SemiMajorAxis;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0", ClampMax = "0.99"))
+	float Eccentricity;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "deg"))
+	float Inclination;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "deg"))
+	float LongitudeOfAscendingNode;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "deg"))
+	float ArgumentOfPeriapsis;
+	
+	/**
+	 * At the start of the first year.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "deg"))
+	float MeanAnomalyAtEpoch;
+	
+	/**
+	 * In planet days.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.01"))
+	float OrbitalPeriod;
+	
+	FAetherCelestialBodyDescription()
+	{
+		Name = NAME_None;
+		Type = EAetherCelestialBodyType::Sun;
+		SemiMajorAxis = 1.0f;
+		Eccentricity = 0.0f;
+		Inclination = 0.0f;
+		LongitudeOfAscendingNode = 0.0f;
+		ArgumentOfPeriapsis = 0.0f;
+		MeanAnomalyAtEpoch = 0.0f;
+		OrbitalPeriod = 96.0f;
+	}
+};
+
+/**
+ * How FAetherState::BlendN merges a field over the weighted states.
+ */
+enum class EAetherStateBlendMode : uint8
+{
+	// Weighted mean.
+	Linear,
+	// Weighted mean of directions, normalized again.
+	NormalizedVector,
+	// Weighted circular mean of a value that wraps around over the period.
+	Angular,
+};
+
+enum class EAetherStateFieldType : uint8
+{
+	Float,
+	Vector,
+	Vector4f,
+};
+
+enum class EAetherStateFieldGroup : uint8
+{
+	None		= 0,
+	// Location, clock and sky, shared by every streaming source.
+	Celestial	= 1 << 0,
+	Weather		= 1 << 1,
+	All			= Celestial | Weather,
+};
+ENUM_CLASS_FLAGS(EAetherStateFieldGroup);
+
+/**
+ * Describes a field of FAetherState, see FAetherState::GetFields.
+ */
+struct FAetherStateField
+{
+	uint32 Offset;
+	EAetherStateFieldType Type;
+	EAetherStateBlendMode BlendMode;
+	EAetherStateFieldGroup Group;
+	// Angular only, the blend wraps into [Min, Min + Period).
+	float Min;
+	float Period;
+};
+
 USTRUCT(BlueprintType)
 struct AETHER_API FAetherState
 {
@@ -124,6 +290,21 @@ struct AETHER_API FAetherState
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FVector MoonLightDirection;
 	
+	/**
+	 * Sun-Moon-Observer angle, 0 at full moon, 180 at new moon.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "deg"))
+	float MoonPhaseAngle;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MoonIlluminatedFraction;
+	
+	/**
+	 * Lux, with the moon at zenith and no atmosphere extinction.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "lux"))
+	float MoonIlluminance;
+	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "C"))
 	float AirTemperature;
 	
@@ -157,6 +338,15 @@ struct AETHER_API FAetherState
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "%"))
 	float CloudCoverage;
 	
+	/**
+	 * Shelter of the observer from precipitation, 1 indoors. RainFall and SnowFall of a streaming source are already masked by it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float PrecipitationShelter;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float WindShelter;
+	
 	float Time;
 	
 	float TestValue;
@@ -169,7 +359,128 @@ struct AETHER_API FAetherState
 	
 	void Normalize();
 	
+	/**
+	 * Compile-time table of the fields BlendN and the operators walk. Month, the shelters and TestValue are not in it,
+	 * the shelters are set per streaming source from the shelter volumes.
+	 */
+	static TConstArrayView<FAetherStateField> GetFields();
+	
+	/**
+	 * Blend the fields of Groups over States in a single pass, the weights are normalized by their sum.
+	 * Other fields of Out are kept, Out may be one of States. Nothing is written if no state has weight.
+	 */
+	static void BlendN(TConstArrayView<const FAetherState*> States, TConstArrayView<float> Weights, FAetherState& Out, EAetherStateFieldGroup Groups = EAetherStateFieldGroup::All);
+	
+	void CopyFields(const FAetherState& From, EAetherStateFieldGroup Groups);
+	
 	FAetherState operator*(float Operand);
 	
 	FAetherState operator+(const FAetherState& Another);
+};
+
+/**
+ * What the world subsystem keeps of an area controller while its World Partition cell is unloaded.
+ * Baked into AAetherGlobalController in the editor, the snapshot part is refreshed when the actor streams out at runtime.
+ */
+USTRUCT()
+struct AETHER_API FAetherAreaControllerProxy
+{
+	GENERATED_BODY()
+	
+	UPROPERTY()
+	FGuid ProxyId;
+	
+	UPROPERTY()
+	FGuid ParentProxyId;
+	
+	UPROPERTY()
+	int32 Priority;
+	
+	UPROPERTY()
+	FTransform Transform;
+	
+	UPROPERTY()
+	EAetherInfluenceShape InfluenceShape;
+	
+	UPROPERTY()
+	float AffectRadius;
+	
+	UPROPERTY()
+	FVector InfluenceExtent;
+	
+	UPROPERTY()
+	TArray<FVector2D> InfluenceConvexPoints;
+	
+	/**
+	 * World space samples of the spline corridor.
+	 */
+	UPROPERTY()
+	TArray<FVector> InfluencePolyline;
+	
+	UPROPERTY()
+	float DaytimeSpeedScale;
+	
+	UPROPERTY()
+	float NightSpeedScale;
+	
+	UPROPERTY()
+	float EvaporationCapacity;
+	
+	UPROPERTY()
+	float SurfaceWater;
+	
+	UPROPERTY()
+	FAetherState State;
+	
+	// Set when the actor streamed out at runtime, the actor takes the snapshot back when it streams in again.
+	bool bHasSnapshot;
+	
+	FAetherAreaControllerProxy();
+	
+	void BuildInfluenceShape(struct FAetherInfluenceShape& OutShape) const;
+};
+
+/**
+ * A storm cell drifting with its own velocity and the steering wind, see UAetherWorldSubsystem::SpawnStormCell.
+ */
+USTRUCT(BlueprintType)
+struct AETHER_API FAetherStormCellDescription
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Location;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "cm", ClampMin = "1.0"))
+	float Radius;
+	
+	/**
+	 * Weight of the weather at the center, it falls off to zero at the radius.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Intensity;
+	
+	/**
+	 * Centimeter per second, on top of the steering wind of AAetherGlobalController.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Velocity;
+	
+	/**
+	 * Game seconds, 0 lives until removed.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ForceUnits = "s", ClampMin = "0.0"))
+	float Lifetime;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FAetherState Weather;
+	
+	FAetherStormCellDescription()
+	{
+		Location = FVector::ZeroVector;
+		Radius = 100000.0f;
+		Intensity = 1.0f;
+		Velocity = FVector::ZeroVector;
+		Lifetime = 0.0f;
+	}
 };
\ No newline at end of file
@@ -8,10 +8,130 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 
+#include "AetherCelestialEventSchedule.h"
+#include "AetherCelestialFrame.h"
+#include "AetherCelestialTracker.h"
+#include "AetherClimatologyAsset.h"
+#include "AetherEphemerisTable.h"
+#include "AetherInfluenceShape.h"
+#include "AetherKeplerSolver.h"
+#include "AetherSimulationClock.h"
+#include "AetherSpatialHash.h"
+#include "AetherSpatialIndex.h"
+#include "AetherStormField.h"
 #include "AetherTypes.h"
 
 #include "AetherWorldSubsystem.generated.h"
 
+/**
+ * Read-only view of the active area controllers, heaviest first. Valid until the next evaluation.
+ */
+struct FAetherActiveControllerView
+{
+	FAetherActiveControllerView(TConstArrayView<TObjectPtr<class AAetherAreaController>> InControllers, TConstArrayView<FAetherAreaControllerProxy> InProxies, TConstArrayView<int32> InIndices, TConstArrayView<float> InWeights)
+		: Controllers(InControllers)
+		, Proxies(InProxies)
+		, Indices(InIndices)
+		, Weights(InWeights)
+	{
+	}
+	
+	FORCEINLINE int32 Num() const { return Indices.Num(); }
+	
+	// Null while the controller is streamed out, or if it was destroyed since the evaluation.
+	FORCEINLINE AAetherAreaController* GetController(int32 Index) const { return Controllers[Indices[Index]]; }
+	
+	// Simulation snapshot only valid while the controller is streamed out.
+	FORCEINLINE const FAetherAreaControllerProxy& GetProxy(int32 Index) const { return Proxies[Indices[Index]]; }
+	FORCEINLINE float GetWeight(int32 Index) const { return Weights[Index]; }
+	
+	// Index into UAetherWorldSubsystem::AreaControllers.
+	FORCEINLINE int32 GetControllerIndex(int32 Index) const { return Indices[Index]; }
+	
+	float FindWeight(const AAetherAreaController* InController) const
+	{
+		for (int32 Index = 0; Index < Indices.Num(); Index++)
+		{
+			if (Controllers[Indices[Index]] == InController)
+			{
+				return Weights[Index];
+			}
+		}
+		return 0.0f;
+	}
+	
+private:
+	TConstArrayView<TObjectPtr<AAetherAreaController>> Controllers;
+	TConstArrayView<FAetherAreaControllerProxy> Proxies;
+	TConstArrayView<int32> Indices;
+	TConstArrayView<float> Weights;
+};
+
+/**
+ * A location the weather is evaluated around, one per player controller, or the editor viewport.
+ */
+struct AETHER_API FAetherStreamingSource
+{
+	FAetherStreamingSource();
+	
+	FVector Location;
+	
+	// Null for the editor viewport.
+	TWeakObjectPtr<class APlayerController> PlayerController;
+	
+	// Index into UAetherWorldSubsystem::AreaControllers and normalized weight of the active area controllers, heaviest first.
+	TArray<int32> ActiveControllerIndices;
+	TArray<float> ActiveControllerWeights;
+	
+	// Weather of the active area controllers blended by weight, the remaining weight keeps the system state.
+	FAetherState State;
+	
+	// Climatology of the global controller at Location, valid if bHasClimate.
+	FAetherClimateSample Climate;
+	bool bHasClimate;
+	
+	// Index into UAetherWorldSubsystem::StormField and weight of the storm cells over Location.
+	TArray<TPair<int32, float>> StormWeights;
+	TArray<int32> StormCandidates;
+	
+	// Largest shelter of the shelter volumes containing Location, 0 outdoors.
+	float PrecipitationShelter;
+	float WindShelter;
+	FVector LastShelterLocation;
+	bool bShelterDirty;
+	
+	// Cache for calculation.
+	TArray<int32> Candidates;
+	TArray<TPair<int32, float>> CandidateWeights;
+	TArray<TPair<int32, float>> ResolvedWeights;
+	
+	// Location and real time of the last full evaluation.
+	FVector LastEvaluationLocation;
+	double LastEvaluationTime;
+	bool bDirty;
+	
+	// Cache for calculation. Found again by the gather of this tick.
+	bool bGathered;
+};
+
+enum class EAetherAvatarType : uint8
+{
+	Lighting,
+	Cloud,
+	Puddle,
+	Other,
+	Num,
+};
+
+/**
+ * Where the avatar of a registration handle is, in the avatar array of its type.
+ */
+struct FAetherAvatarSlot
+{
+	EAetherAvatarType Type;
+	int32 Index;
+};
+
 UCLASS(NotBlueprintable)
 class AETHER_API UAetherWorldSubsystem : public UTickableWorldSubsystem
 {
@@ -21,15 +141,81 @@ protected:
 	UPROPERTY()
 	TObjectPtr<class AAetherGlobalController> GlobalController;
 	
+	// Runs the weather events of the climatology, spawned in game worlds while the global controller has one.
+	UPROPERTY()
+	TObjectPtr<class AAetherBackgroundController> BackgroundController;
+	
+	// Null while the controller is streamed out with its World Partition cell, its slot and proxy stay.
+	UPROPERTY()
+	TArray<TObjectPtr<AAetherAreaController>> AreaControllers;
+	
+	// Proxy of AreaControllers in the same order, and the slot of each proxy id.
+	TArray<FAetherAreaControllerProxy> AreaControllerProxies;
+	TMap<FGuid, int32> AreaControllerSlots;
+	
+	// Slot of each registration handle, and the handle of each slot, INDEX_NONE while streamed out.
+	// Removing a controller moves the last slot into its place.
+	TSparseArray<int32> AreaControllerHandles;
+	TArray<int32> AreaControllerSlotHandles;
+	
+	// Local players first, the first source drives the diel rhythm, the avatars and the material parameters.
+	TArray<FAetherStreamingSource> StreamingSources;
+	
+	// Influence shapes of AreaControllers in the same order, rebuilt on register and unregister, refit when a controller moves or reshapes.
+	FAetherSpatialIndex AreaControllerIndex;
+	TArray<FAetherInfluenceShape> AreaControllerShapes;
+	
+	// Controllers without a registered parent, the items of AreaControllerIndex with their bounds.
+	TArray<int32> AreaControllerRoots;
+	TArray<FBox> AreaControllerBounds;
+	
+	// Children of AreaControllers[i] are AreaControllerChildren[AreaControllerChildOffsets[i], AreaControllerChildOffsets[i + 1]), highest priority first.
+	TArray<int32> AreaControllerChildOffsets;
+	TArray<int32> AreaControllerChildren;
+
+	// Hot fields of AreaControllers in the same order, synced from the proxies when a controller changes.
+	TArray<float> AreaControllerDaytimeSpeedScales;
+	TArray<float> AreaControllerNightSpeedScales;
+	
+	// Weather each controller contributes, synced once per tick for the active controllers of every streaming source.
+	TArray<FAetherState> AreaControllerStates;
+	
+	// Slots whose proxy, shape and hot fields are refreshed on the next UpdateAreaControllerIndex, all of them when the index is dirty.
+	TArray<int32> DirtyAreaControllerSlots;
+	
+	bool bAreaControllerIndexDirty;
+	bool bAreaControllerBoundsDirty;
+	
+	UPROPERTY()
+	TArray<TObjectPtr<class AAetherShelterVolume>> ShelterVolumes;
+	
+	// Bounds of ShelterVolumes in the same order, rebuilt when any of them changes.
+	FAetherSpatialHash ShelterHash;
+	bool bShelterHashDirty;
+	
+	// Cache for calculation.
+	TArray<int32> ShelterCandidates;
+	
+	FAetherStormField StormField;
+	
+	// By EAetherAvatarType, classified once on register. Removing an avatar moves the last one of its type into its place.
+	UPROPERTY()
+	TArray<TObjectPtr<class AAetherAvatarBase>> LightingAvatars;
+	
 	UPROPERTY()
-	TArray<TObjectPtr<class AAetherAreaController>> AreaControllers;
+	TArray<TObjectPtr<AAetherAvatarBase>> CloudAvatars;
 	
 	UPROPERTY()
-	TMap<TObjectPtr<AAetherAreaController>, float> ActiveControllers;
+	TArray<TObjectPtr<AAetherAvatarBase>> PuddleAvatars;
 	
 	UPROPERTY()
-	TArray<TObjectPtr<class AAetherAvatarBase>> Avatars;
+	TArray<TObjectPtr<AAetherAvatarBase>> OtherAvatars;
 	
+	// Slot of each registration handle, and the handle of each avatar in the arrays above.
+	TSparseArray<FAetherAvatarSlot> AvatarHandles;
+	TArray<int32> AvatarSlotHandles[(int32)EAetherAvatarType::Num];
+	
+	// Last registered of their type, drive the sky and the rain.
 	UPROPERTY()
 	TObjectPtr<class AAetherLightingAvatar> LightingAvatar;
 	
@@ -42,9 +228,38 @@ protected:
 	UPROPERTY()
 	FAetherState SystemState;
 	
-	// Cache for calculation.
+	// Cache for calculation. Location of the first streaming source, W is negative without one.
 	FVector4f StreamingSourceLocation;
 	
+	// Simulated time, SystemState.ProgressOfYear and SystemState.Time are float views of it.
+	FAetherSimulationClock SimulationClock;
+	
+	FAetherEphemerisTable EphemerisTable;
+	
+	// Rebuilt at the start of every diel rhythm update, see UpdatePlanetByTime.
+	FAetherCelestialFrame CelestialFrame;
+	
+	FAetherCelestialTracker CelestialTracker;
+	
+	FAetherCelestialEventSchedule CelestialEventSchedule;
+	
+	// Cache for calculation. Moon age angle at the start and the end of the simulated day.
+	int32 MoonPhaseCachedDay;
+	FVector2f MoonAgeAngleOfDay;
+	
+	// Diel rhythm of the simulated planet, selected once in InitializeAetherSystem.
+	void (UAetherWorldSubsystem::*UpdateSystemState_DielRhythm_Planet)(float DeltaTime);
+	
+	//~ Begin Custom Planet
+	FAetherKeplerSolver CustomBodySolver;
+	
+	// Horizon frame direction from the observer to each body of AAetherGlobalController::CelestialBodies.
+	TArray<FVector3f> CustomBodyDirections;
+	
+	int32 CustomPrimarySunIndex;
+	int32 CustomPrimaryMoonIndex;
+	//~ End Custom Planet
+	
 public:
 	UAetherWorldSubsystem();
 	
@@ -73,12 +288,59 @@ public:
 	void RegisterController(class AAetherControllerBase* InController);
 	void UnregisterController(AAetherControllerBase* InController);
 	
+	/**
+	 * The area controller streams out, its slot keeps weighting the proxy with a snapshot of its simulation.
+	 */
+	void DetachAreaController(AAetherAreaController* InController);
+	
+	/**
+	 * Location or influence shape of a registered area controller changed.
+	 */
+	void NotifyAreaControllerBoundsChanged(AAetherAreaController* InController);
+	
+	/**
+	 * Diel rhythm or evaporation of a registered area controller changed, e.g. from gameplay code.
+	 */
+	void NotifyAreaControllerDataChanged(AAetherAreaController* InController);
+	
+	/**
+	 * Parent or priority of a registered area controller changed.
+	 */
+	void NotifyAreaControllerHierarchyChanged(AAetherAreaController* InController);
+	
+	/**
+	 * Registering again marks the volume as changed.
+	 */
+	void RegisterShelter(AAetherShelterVolume* InShelter);
+	void UnregisterShelter(AAetherShelterVolume* InShelter);
+	
+	/**
+	 * Returns the id of the storm cell, it blends over the area controllers until its lifetime ends or it is removed.
+	 */
+	int32 SpawnStormCell(const FAetherStormCellDescription& Description);
+	void RemoveStormCell(int32 CellId);
+	
 	void RegisterAvatar(AAetherAvatarBase* InAvatar);
 	void UnregisterAvatar(AAetherAvatarBase* InAvatar);
 	
 	void TriggerWeatherEventImmediately(const FGameplayTag& EventTag);
 	
 	void InitializeAetherSystem();
+	
+	/**
+	 * Jump the simulated time without stepping, e.g. sleeping, fast travel or loading a save.
+	 * Sun, moon and custom bodies are solved directly at the target time, area controllers fast-forward their weather
+	 * and surface water in closed form, avatars and material parameters update once at the end.
+	 * Celestial events inside the skipped span are not broadcast.
+	 */
+	void AdvanceTo(int64 Year, int64 TickOfYear);
+	void AdvanceBy(double SimulatedSeconds);
+	
+	/**
+	 * Called once when the simulated time crosses the event at the current coordinate.
+	 */
+	FDelegateHandle SubscribeCelestialEvent(EAetherCelestialEvent Event, FAetherCelestialEventSignature::FDelegate&& Delegate);
+	void UnsubscribeCelestialEvent(EAetherCelestialEvent Event, FDelegateHandle Handle);
 	//~ End UAetherWorldSubsystem Interface
 	
 protected:
@@ -90,12 +352,52 @@ protected:
 	
 	void EvaluateActiveControllers();
 	
+	void GatherStreamingSources();
+	
+	void UpdateShelterOccupancy();
+	
+	// Thread safe, only reads the area controllers and their index.
+	void EvaluateStreamingSource(FAetherStreamingSource& Source, bool bForce, double CurrentTime) const;
+	void DistributeControllerWeight(FAetherStreamingSource& Source, int32 ControllerIndex, float Weight) const;
+	void BlendStreamingSourceState(FAetherStreamingSource& Source) const;
+	
+	static float EvaluateControllerWeight(EAetherWeightKernel Kernel, float SurfaceDistance, float Range);
+	
+	void ImportAreaControllerProxies();
+	void UpdateAreaControllerProxies(float DeltaTime);
+	
+	void SyncActiveControllerStates();
+	
+	bool IsAreaControllerRegistered(const AAetherAreaController* InController) const;
+	
+	bool IsAvatarRegistered(const AAetherAvatarBase* InAvatar);
+	TArray<TObjectPtr<AAetherAvatarBase>>& GetAvatars(EAetherAvatarType Type);
+	
+	void UpdateAreaControllerIndex();
+	void RebuildAreaControllerHierarchy();
+	void RefreshAreaControllerSlot(int32 SlotIndex);
+	void MarkAreaControllerDirty(const AAetherAreaController* InController, bool bBoundsChanged);
+	void OnAreaControllerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	
 	void UpdateSourceCoordinate();
 	
+	void InitializePlanetModel();
+	
 	void UpdateSystemState_DielRhythm(float DeltaTime);
 	
+	void GetDielSpeedScales(float& OutDaytimeSpeedScale, float& OutNightSpeedScale) const;
+	float CalculateDielDeltaTime(float DeltaTime) const;
+	void AdvanceSimulationClock(float DeltaTime);
+	void OnSimulationTimeJumped(double SimulatedSeconds);
+	
+	/**
+	 * Game seconds the diel rhythm takes for SimulatedSeconds just jumped over, by the day and night speed scales.
+	 */
+	double CalculateJumpGameSeconds(double SimulatedSeconds) const;
+	
 	void UpdateSystemState_DielRhythm_Earth(float DeltaTime);
-	void UpdatePlanetByTime();
+	void UpdatePlanetByTime(float DeltaTime);
+	void UpdateMoonPhase();
 	
 	void UpdateSystemState_DielRhythm_Custom(float DeltaTime);
 	
@@ -104,6 +406,8 @@ protected:
 	void EvaluateWeatherEvent(float DeltaTime);
 	void UpdateWeatherEvent(float DeltaTime);
 	
+	void UpdateBackgroundController();
+	
 	void UpdateWorld();
 	
 	void UpdateAvatar();
@@ -111,6 +415,14 @@ protected:
 	void UpdateSystemMaterialParameter();
 	
 public:
-	FORCEINLINE const TMap<TObjectPtr<AAetherAreaController>, float>& GetActiveControllers() const { return ActiveControllers; }
+	FAetherActiveControllerView GetActiveControllers(int32 SourceIndex = 0) const;
+	FORCEINLINE AAetherGlobalController* GetGlobalController() const { return GlobalController; }
+	FORCEINLINE AAetherBackgroundController* GetBackgroundController() const { return BackgroundController; }
+	FORCEINLINE const TArray<FAetherStreamingSource>& GetStreamingSources() const { return StreamingSources; }
 	FORCEINLINE const FAetherState& GetSystemState() const { return SystemState; }
+	FORCEINLINE const FAetherStormField& GetStormField() const { return StormField; }
+	FORCEINLINE const FAetherSimulationClock& GetSimulationClock() const { return SimulationClock; }
+	FORCEINLINE const FAetherCelestialEventSchedule& GetCelestialEventSchedule() const { return CelestialEventSchedule; }
+	FORCEINLINE const FAetherCelestialFrame& GetCelestialFrame() const { return CelestialFrame; }
+	FORCEINLINE const TArray<FVector3f>& GetCustomBodyDirections() const { return CustomBodyDirections; }
 };
\ No newline at end of file
@@ -17,6 +17,11 @@ class AETHER_API AAetherAvatarBase : public AActor
 {
 	GENERATED_BODY()
 	
+	friend class UAetherWorldSubsystem;
+	
+	// Given by UAetherWorldSubsystem::RegisterAvatar.
+	int32 RegistrationHandle;
+	
 public:
 	AAetherAvatarBase();
 	
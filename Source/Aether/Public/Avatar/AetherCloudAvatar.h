@@ -21,6 +21,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Aether|Component", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<class UNiagaraComponent> RainFXComponent;
 	
+	// Rain FX was deactivated by the shelter of the view, not by its own settings.
+	bool bRainFXSheltered;
+	
 public:
 	AAetherCloudAvatar();
 	
@@ -30,6 +30,12 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Aether|Component", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<USkyLightComponent> SkyLightComponent;
 	
+	/**
+	 * Moonlight affects the world and casts shadows only at night above this ground illuminance, dark nights skip the shadow pass.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Lighting", meta = (AllowPrivateAccess = "true", ForceUnits = "lux", ClampMin = "0.0"))
+	float MoonLightIlluminanceThreshold;
+	
 public:
 	AAetherLightingAvatar();
 	
@@ -34,15 +34,67 @@ protected:
 #endif
 	
 	//~ Begin System Config Property
+	/**
+	 * Finds the baked proxy of this controller, see AAetherGlobalController::AreaControllerProxies.
+	 */
+	UPROPERTY(VisibleAnywhere, NonPIEDuplicateTransient, Category = "Aether|System", AdvancedDisplay)
+	FGuid ProxyId;
+	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|System")
+	EAetherInfluenceShape InfluenceShape;
+	
+	/**
+	 * Radius of the sphere, half width of the spline corridor.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|System", meta = (EditCondition = "InfluenceShape == EAetherInfluenceShape::Sphere || InfluenceShape == EAetherInfluenceShape::Spline", EditConditionHides))
 	float AffectRadius;
 	
+	/**
+	 * Half size of the box in local space. Z is also the half height of the convex shape.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|System", meta = (EditCondition = "InfluenceShape == EAetherInfluenceShape::Box || InfluenceShape == EAetherInfluenceShape::Convex", EditConditionHides))
+	FVector InfluenceExtent;
+	
+	/**
+	 * Local XY, the influence covers their convex hull.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|System", meta = (EditCondition = "InfluenceShape == EAetherInfluenceShape::Convex", EditConditionHides))
+	TArray<FVector2D> InfluenceConvexPoints;
+	
+	/**
+	 * Path of the spline corridor.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Aether|System")
+	TObjectPtr<class USplineComponent> InfluenceSpline;
+	
 #if WITH_EDITORONLY_DATA
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|System")
 	TObjectPtr<class UAetherSystemPreset> EarthLocationPreset;
 #endif
 	//~ End System Config Property
 	
+	//~ Begin Hierarchy Property
+	/**
+	 * Inside this controller the weight of the parent moves over to it by its falloff.
+	 * Children are only evaluated where their parent has weight, keep them inside the parent.
+	 * Soft, a hard actor reference would pull parent and child into the same World Partition loading group.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Aether|Hierarchy")
+	TSoftObjectPtr<AAetherAreaController> ParentController;
+	
+	/**
+	 * ProxyId of ParentController, taken when it is set in the editor so the hierarchy resolves while the parent is unloaded.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Aether|Hierarchy", AdvancedDisplay)
+	FGuid ParentProxyId;
+	
+	/**
+	 * Among children of the same parent a higher priority takes its share first.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Hierarchy")
+	int32 Priority;
+	//~ End Hierarchy Property
+	
 	//~ Begin Diel Rhythm Property
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Diel Rhythm")
 	float DaytimeSpeedScale;
@@ -93,6 +145,9 @@ protected:
 	
 	float SinceLastTickTime;
 	
+	// Given by UAetherWorldSubsystem::RegisterController.
+	int32 RegistrationHandle;
+	
 	int32 TestCount = 0;
 	
 public:
@@ -104,9 +159,29 @@ public:
 	virtual bool CanEditChange(const FProperty* InProperty) const override;
 #endif
 	
+	virtual void PostInitProperties() override;
+	
 	virtual void PostLoad() override;
 	//~ End UObject Interface
 	
+	//~ Begin AActor Interface
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
+#if WITH_EDITOR
+	virtual bool CanChangeIsSpatiallyLoadedFlag() const override { return true; }
+#endif
+	//~ End AActor Interface
+	
+	/**
+	 * Shape, hierarchy and climate in world space, and a snapshot of the simulation. Called on the game thread.
+	 */
+	void MakeProxy(struct FAetherAreaControllerProxy& OutProxy) const;
+	
+	/**
+	 * Continue the simulation from the snapshot taken when the controller streamed out.
+	 */
+	void ApplyProxySnapshot(const FAetherAreaControllerProxy& Proxy);
+	
 #if UE_ENABLE_DEBUG_DRAWING
 	void DrawDebugPointInfo(const FColor& Color) const;
 #endif
@@ -126,6 +201,18 @@ protected:
 	virtual void EvaluateWeatherEvent(float DeltaTime);
 	virtual void UpdateWeatherEvent(float DeltaTime);
 	
+	/**
+	 * Chance of PossibleWeatherEvents[Index] this month, an event is only triggered above zero.
+	 */
+	virtual float GetWeatherEventProbability(int32 Index) const;
+	
+	/**
+	 * Jump DeltaTime ahead without stepping, see UAetherWorldSubsystem::AdvanceBy.
+	 * Running weather instances walk their remaining phase times, the surface water is integrated in closed form.
+	 */
+	virtual void FastForward(float DeltaTime);
+	void FastForwardWeatherEvent(float DeltaTime);
+	
 public:
     void TriggerWeatherEventImmediately(const FGameplayTag& EventTag);
     void TriggerWeatherEventImmediately(const FGameplayTagContainer& EventTags);
@@ -141,6 +228,14 @@ private:
 	
 protected:
 	virtual void CalcSurfaceCoeffcient(float DeltaTime);
+	void UpdateSurfaceState();
+	
+public:
+	/**
+	 * Closed form of the surface water over DeltaTime with constant rain fall, shared with the proxies of streamed out controllers.
+	 */
+	static float IntegrateSurfaceWater(float SurfaceWater, float RainFall, float EvaporationCapacity, float DeltaTime);
+	static void ApplySurfaceWater(FAetherState& State, float SurfaceWater);
 	
 private:
 #if WITH_EDITOR
@@ -152,7 +247,18 @@ private:
 #endif
 	
 public:
+	FORCEINLINE const FGuid& GetProxyId() const { return ProxyId; }
+	
 	FORCEINLINE const float& GetAffectRadius() const { return AffectRadius; }
+	FORCEINLINE EAetherInfluenceShape GetInfluenceShape() const { return InfluenceShape; }
+	FORCEINLINE const FVector& GetInfluenceExtent() const { return InfluenceExtent; }
+	FORCEINLINE const TArray<FVector2D>& GetInfluenceConvexPoints() const { return InfluenceConvexPoints; }
+	FORCEINLINE USplineComponent* GetInfluenceSpline() const { return InfluenceSpline; }
+	
+	// Null while the parent is not loaded.
+	FORCEINLINE AAetherAreaController* GetParentController() const { return ParentController.Get(); }
+	FORCEINLINE const FGuid& GetParentProxyId() const { return ParentProxyId; }
+	FORCEINLINE int32 GetPriority() const { return Priority; }
 	
 	FORCEINLINE FAetherState& GetCurrentState() { return CurrentState; }
 	FORCEINLINE const FAetherState& GetCurrentState() const { return CurrentState; }
@@ -0,0 +1,48 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AetherAreaController.h"
+#include "AetherClimatologyAsset.h"
+
+#include "AetherBackgroundController.generated.h"
+
+/**
+ * Weather where no area controller is placed. Spawned by the world subsystem while the global controller has a climatology,
+ * its weather events are the events of the climatology and take their chance from the climate at the view instead of the month.
+ * Not weighted by location, every streaming source blends it under the area controllers.
+ */
+UCLASS(NotPlaceable, NotBlueprintable, Transient)
+class AETHER_API AAetherBackgroundController : public AAetherAreaController
+{
+	GENERATED_BODY()
+	
+	friend class UAetherWorldSubsystem;
+	
+protected:
+	UPROPERTY(Transient)
+	TObjectPtr<UAetherClimatologyAsset> Climatology;
+	
+	FAetherClimateSample Climate;
+	bool bHasClimate;
+	
+public:
+	AAetherBackgroundController();
+	
+	/**
+	 * Climate at the view, PossibleWeatherEvents follows the events of InClimatology.
+	 */
+	void SetClimate(UAetherClimatologyAsset* InClimatology, const FAetherClimateSample& InClimate, bool bInHasClimate);
+	
+protected:
+	virtual float GetWeatherEventProbability(int32 Index) const override;
+	
+public:
+	FORCEINLINE const FAetherClimateSample& GetClimate() const { return Climate; }
+	FORCEINLINE bool HasClimate() const { return bHasClimate; }
+};
\ No newline at end of file
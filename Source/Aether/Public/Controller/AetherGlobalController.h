@@ -45,31 +45,65 @@ protected:
 	ESimulatePlanetType SimulatePlanet;
 	
 	// 纬度
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "deg", EditCondition = "SimulatePlanet == ESimulatePlanetType::Earth", EditConditionHides))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "deg"))
 	float Latitude;
 	
 	// 经度
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "deg", EditCondition = "SimulatePlanet == ESimulatePlanetType::Earth", EditConditionHides))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "deg"))
 	float Longitude;
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "m", EditCondition = "SimulatePlanet == ESimulatePlanetType::Earth", EditConditionHides))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "m"))
 	float NorthDisPerDegreeLatitude;
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "m", EditCondition = "SimulatePlanet == ESimulatePlanetType::Earth", EditConditionHides))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "m"))
 	float EastDisPerDegreeLongitude;
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "s", EditCondition = "SimulatePlanet == ESimulatePlanetType::Earth", EditConditionHides, ClampMin = "1.0"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "s", ClampMin = "1.0"))
 	float PeriodOfDay;
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (EditCondition = "SimulatePlanet == ESimulatePlanetType::Earth", EditConditionHides, ClampMin = "1"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ClampMin = "1"))
 	int32 DaysOfMonth;
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "deg", EditCondition = "SimulatePlanet == ESimulatePlanetType::Earth", EditConditionHides))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "deg"))
 	float NorthDirectionYawOffset;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Settings", meta = (ForceUnits = "s"))
 	float InitTimeStampOfYear;
 	
+	/**
+	 * Tilt of the rotation axis against the orbital plane of the planet.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Custom Planet", meta = (ForceUnits = "deg", EditCondition = "SimulatePlanet == ESimulatePlanetType::CustomPlanet", EditConditionHides, ClampMin = "0.0", ClampMax = "180.0"))
+	float PlanetAxialTilt;
+	
+	/**
+	 * One turn of the planet against the fixed stars, in planet days. Slightly shorter than a day for a prograde planet.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Custom Planet", meta = (EditCondition = "SimulatePlanet == ESimulatePlanetType::CustomPlanet", EditConditionHides, ClampMin = "0.01"))
+	float PlanetRotationPeriod;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Custom Planet", meta = (EditCondition = "SimulatePlanet == ESimulatePlanetType::CustomPlanet", EditConditionHides))
+	TArray<FAetherCelestialBodyDescription> CelestialBodies;
+	
+	/**
+	 * Background climate of the world, area controllers are only needed where it does not fit.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Climatology")
+	TObjectPtr<class UAetherClimatologyAsset> Climatology;
+	
+	/**
+	 * Centimeter per second in world XY, carries every storm cell along.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aether|Storm")
+	FVector2D StormSteeringWind;
+	
+	/**
+	 * Area controllers of every World Partition cell, weighted in their place while the cell is unloaded.
+	 * Built by BakeAreaControllerProxies, bake again after adding, editing or deleting area controllers.
+	 */
+	UPROPERTY()
+	TArray<FAetherAreaControllerProxy> AreaControllerProxies;
+	
 public:
 	AAetherGlobalController();
 	
@@ -80,9 +114,18 @@ public:
 #endif
 	//~ End UObject Interface
 	
+	FORCEINLINE const TArray<FAetherAreaControllerProxy>& GetAreaControllerProxies() const { return AreaControllerProxies; }
+	
 private:
 #if WITH_EDITOR
 	UFUNCTION(CallInEditor, Category = "Aether")
 	void CaptureTimeStamp();
+	
+	/**
+	 * Replace the proxies by every area controller of the world. Unloaded World Partition cells are loaded in batches,
+	 * a deleted controller drops out. Save this actor afterwards.
+	 */
+	UFUNCTION(CallInEditor, Category = "Aether")
+	void BakeAreaControllerProxies();
 #endif
 };
\ No newline at end of file
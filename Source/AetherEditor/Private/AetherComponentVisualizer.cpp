@@ -6,9 +6,11 @@
 #include "AetherComponentVisualizer.h"
 
 #include "CanvasTypes.h"
+#include "Components/SplineComponent.h"
 #include "Engine/Font.h"
 
 #include "AetherAreaController.h"
+#include "AetherInfluenceShape.h"
 #include "AetherGlobalController.h"
 #include "AetherWorldSubsystem.h"
 
@@ -160,26 +162,76 @@ void FAetherAreaControllerComponentVisualizer::DrawVisualization(const UActorCom
 			FLinearColor DrawColor = FLinearColor::Red;
 			if (const UAetherWorldSubsystem* Subsystem = UAetherWorldSubsystem::Get(Owner))
 			{
-				for (auto It = Subsystem->GetActiveControllers().CreateConstIterator(); It; ++It)
-                {
-					if (It.Key() == Owner)
+				DrawColor = FMath::Lerp(FLinearColor::Red, FLinearColor::Green, Subsystem->GetActiveControllers().FindWeight(Owner));
+			}
+			switch (Owner->GetInfluenceShape())
+			{
+			case EAetherInfluenceShape::Box:
+				DrawOrientedWireBox(PDI,
+					LocalToWorld.GetOrigin(),
+					LocalToWorld.GetUnitAxis(EAxis::X),
+					LocalToWorld.GetUnitAxis(EAxis::Y),
+					LocalToWorld.GetUnitAxis(EAxis::Z),
+					Owner->GetInfluenceExtent(),
+					DrawColor,
+					SDPG_World);
+				break;
+			case EAetherInfluenceShape::Convex:
+				{
+					TArray<FVector2D> Hull;
+					FAetherInfluenceShape::ComputeConvexHull(Owner->GetInfluenceConvexPoints(), Hull);
+					const FTransform ShapeTransform(Owner->GetActorQuat(), Owner->GetActorLocation());
+					const float HalfHeight = Owner->GetInfluenceExtent().Z;
+					for (int32 Index = 0; Index < Hull.Num(); Index++)
+					{
+						const FVector2D& A = Hull[Index];
+						const FVector2D& B = Hull[(Index + 1) % Hull.Num()];
+						const FVector BottomA = ShapeTransform.TransformPosition(FVector(A.X, A.Y, -HalfHeight));
+						const FVector TopA = ShapeTransform.TransformPosition(FVector(A.X, A.Y, HalfHeight));
+						PDI->DrawLine(BottomA, ShapeTransform.TransformPosition(FVector(B.X, B.Y, -HalfHeight)), DrawColor, SDPG_World);
+						PDI->DrawLine(TopA, ShapeTransform.TransformPosition(FVector(B.X, B.Y, HalfHeight)), DrawColor, SDPG_World);
+						PDI->DrawLine(BottomA, TopA, DrawColor, SDPG_World);
+					}
+				}
+				break;
+			case EAetherInfluenceShape::Spline:
+				if (const USplineComponent* Spline = Owner->GetInfluenceSpline())
+				{
+					// Corridor outline in the horizontal plane, the spline draws itself.
+					const float SplineLength = Spline->GetSplineLength();
+					const int32 NumSegments = FMath::Clamp(FMath::CeilToInt(SplineLength / 200.0f), 1, 256);
+					FVector LastLeft, LastRight;
+					for (int32 Index = 0; Index <= NumSegments; Index++)
 					{
-						DrawColor = FMath::Lerp(FLinearColor::Red, FLinearColor::Green, It.Value());
-						break;
+						const float Distance = SplineLength * Index / NumSegments;
+						const FVector Location = Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+						const FVector Right = Spline->GetRightVectorAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World) * Owner->GetAffectRadius();
+						if (Index > 0)
+						{
+							PDI->DrawLine(LastLeft, Location - Right, DrawColor, SDPG_World);
+							PDI->DrawLine(LastRight, Location + Right, DrawColor, SDPG_World);
+						}
+						LastLeft = Location - Right;
+						LastRight = Location + Right;
 					}
-                }
+				}
+				break;
+			default:
+				{
+					float HalfHeight = FMath::Max(Owner->GetAffectRadius() * 3.0f, 1000.0f) / 2.0f;
+					DrawWireCylinder(PDI,
+						LocalToWorld.GetOrigin() + FVector(0.0f, 0.0f, HalfHeight),
+						LocalToWorld.GetScaledAxis(EAxis::X),
+						LocalToWorld.GetScaledAxis(EAxis::Y),
+						LocalToWorld.GetScaledAxis(EAxis::Z),
+						DrawColor,
+						Owner->GetAffectRadius(),
+						HalfHeight,
+						16,
+						SDPG_World);
+				}
+				break;
 			}
-			float HalfHeight = FMath::Max(Owner->GetAffectRadius() * 3.0f, 1000.0f) / 2.0f;
-			DrawWireCylinder(PDI,
-				LocalToWorld.GetOrigin() + FVector(0.0f, 0.0f, HalfHeight),
-				LocalToWorld.GetScaledAxis(EAxis::X),
-				LocalToWorld.GetScaledAxis(EAxis::Y),
-				LocalToWorld.GetScaledAxis(EAxis::Z),
-				DrawColor,
-				Owner->GetAffectRadius(),
-				HalfHeight,
-				16,
-				SDPG_World);
 		}
 	}
 }
\ No newline at end of file
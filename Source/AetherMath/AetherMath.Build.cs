@@ -0,0 +1,34 @@
+//
+// Aether: Real-Time Sky & Environment & Weather simulation plugin.
+//		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+//
+
+using UnrealBuildTool;
+
+public class AetherMath : ModuleRules
+{
+	public AetherMath(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicIncludePaths.AddRange(
+			new string[] {
+				ModuleDirectory + "/Public",
+			}
+			);
+		
+		PrivateIncludePaths.AddRange(
+			new string[] {
+				ModuleDirectory + "/Private",
+			}
+			);
+		
+		// Celestial math only, no UObject, so it links into programs and headless tools.
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherCelestialFrame.h"
+
+#include "AetherWorldMath.inl"
+
+FAetherCelestialFrame::FAetherCelestialFrame()
+{
+	Build(0.0f, STANDARD_MERIDIAN, 0.0f, 0.0f);
+}
+
+void FAetherCelestialFrame::Build(float Latitude, float Longitude, float TimeStampOfEarthDay, float TimeStampOfEarthYear, bool bFastMath)
+{
+	// Sun hour angle: 15 * (LocalHour + (Longitude - 120) / 15 - 12), as CalculateSunPosition.
+	const float SunHourAngle = FMath::DegreesToRadians(TimeStampOfEarthDay * (DEG_TO_HOUR / SECONDS_PER_HOUR) + Longitude - (STANDARD_MERIDIAN + DEG_TO_HOUR * 12.0f));
+	
+	// Sidereal time reduced as 360 * frac(d) + 0.98564736629 * d to keep the float precision, as CalculateMoonPosition4.
+	const float DaysSince2000 = TimeStampOfEarthYear / SECONDS_PER_DAY_EARTH - 0.5f;
+	const float GreenwichSiderealTime = 280.46061837f + 360.0f * FMath::Frac(DaysSince2000) + 0.98564736629f * DaysSince2000;
+	LocalSiderealTime = FMath::DegreesToRadians(FMath::Fmod(GreenwichSiderealTime + Longitude, 360.0f));
+	
+	float SinSiderealTime, CosSiderealTime;
+	if (bFastMath)
+	{
+		FAetherFastMath::SinCos(&SinLatitude, &CosLatitude, FMath::DegreesToRadians(Latitude));
+		FAetherFastMath::SinCos(&SinSunHourAngle, &CosSunHourAngle, SunHourAngle);
+		FAetherFastMath::SinCos(&SinSiderealTime, &CosSiderealTime, LocalSiderealTime);
+	}
+	else
+	{
+		FMath::SinCos(&SinLatitude, &CosLatitude, FMath::DegreesToRadians(Latitude));
+		FMath::SinCos(&SinSunHourAngle, &CosSunHourAngle, SunHourAngle);
+		FMath::SinCos(&SinSiderealTime, &CosSiderealTime, LocalSiderealTime);
+	}
+	FMath::SinCos(&SinObliquity, &CosObliquity, FMath::DegreesToRadians(OBLIQUITY));
+	
+	BuildRotation(SinSiderealTime, CosSiderealTime);
+}
+
+void FAetherCelestialFrame::BuildFromSiderealTime(float Latitude, float InLocalSiderealTime, float Obliquity, bool bFastMath)
+{
+	LocalSiderealTime = InLocalSiderealTime;
+	
+	// No solar hour angle off Earth, the suns are regular bodies of the frame.
+	SinSunHourAngle = 0.0f;
+	CosSunHourAngle = 1.0f;
+	
+	float SinSiderealTime, CosSiderealTime;
+	if (bFastMath)
+	{
+		FAetherFastMath::SinCos(&SinLatitude, &CosLatitude, FMath::DegreesToRadians(Latitude));
+		FAetherFastMath::SinCos(&SinSiderealTime, &CosSiderealTime, LocalSiderealTime);
+	}
+	else
+	{
+		FMath::SinCos(&SinLatitude, &CosLatitude, FMath::DegreesToRadians(Latitude));
+		FMath::SinCos(&SinSiderealTime, &CosSiderealTime, LocalSiderealTime);
+	}
+	FMath::SinCos(&SinObliquity, &CosObliquity, FMath::DegreesToRadians(Obliquity));
+	
+	BuildRotation(SinSiderealTime, CosSiderealTime);
+}
+
+void FAetherCelestialFrame::BuildRotation(float SinSiderealTime, float CosSiderealTime)
+{
+	// Hour angle H = LST - RA, then the latitude tilt of TransformHourAngle.
+	EquatorialToHorizon[0] = FVector3f(-SinLatitude * CosSiderealTime, -SinLatitude * SinSiderealTime, CosLatitude);
+	EquatorialToHorizon[1] = FVector3f(-SinSiderealTime, CosSiderealTime, 0.0f);
+	EquatorialToHorizon[2] = FVector3f(CosLatitude * CosSiderealTime, CosLatitude * SinSiderealTime, SinLatitude);
+	
+	// Ecliptic to equatorial is a rotation by the obliquity around the equinox axis.
+	for (int32 Row = 0; Row < 3; Row++)
+	{
+		const FVector3f& Equatorial = EquatorialToHorizon[Row];
+		EclipticToHorizon[Row] = FVector3f(
+			Equatorial.X,
+			Equatorial.Y * CosObliquity + Equatorial.Z * SinObliquity,
+			Equatorial.Z * CosObliquity - Equatorial.Y * SinObliquity);
+	}
+}
+
+FVector3f FAetherCelestialFrame::MakeEquatorialDirection(float RightAscension, float Declination)
+{
+	float SinRightAscension, CosRightAscension, SinDeclination, CosDeclination;
+	FMath::SinCos(&SinRightAscension, &CosRightAscension, RightAscension);
+	FMath::SinCos(&SinDeclination, &CosDeclination, Declination);
+	return FVector3f(CosDeclination * CosRightAscension, CosDeclination * SinRightAscension, SinDeclination);
+}
+
+FVector3f FAetherCelestialFrame::MakeEclipticDirection(float EclipticLongitude, float EclipticLatitude)
+{
+	return MakeEquatorialDirection(EclipticLongitude, EclipticLatitude);
+}
+
+void FAetherCelestialFrame::TransformEquatorial(const FVector3f* RESTRICT EquatorialDirection, FVector3f* RESTRICT HorizonDirection, int32 Num) const
+{
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		HorizonDirection[Index] = TransformEquatorial(EquatorialDirection[Index]);
+	}
+}
\ No newline at end of file
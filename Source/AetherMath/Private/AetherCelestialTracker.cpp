@@ -0,0 +1,147 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherCelestialTracker.h"
+
+#include "AetherWorldMath.inl"
+
+namespace AetherCelestialTracker
+{
+	/**
+	 * Radian per unit of ProgressOfYear. The moon hour angle runs on the sidereal time of a 365 days year
+	 * minus the mean motion of its right ascension, see CalculateMoonPosition.
+	 */
+	static const double MoonHourAngleRate = FMath::DegreesToRadians((360.98564736629 - 481267.88123421 / DAYS_PER_CENTURY) * DAYS_PER_YEAR_EARTH);
+	
+	/**
+	 * Never rebuild the interval below this, keep the tracker useful when the drift is persistently high.
+	 */
+	static const float MinResolveInterval = 0.05f;
+}
+
+FAetherCelestialTracker::FAetherCelestialTracker()
+{
+	Invalidate();
+	CurrentInterval = 0.0f;
+	LastDrift = 0.0f;
+}
+
+void FAetherCelestialTracker::Invalidate()
+{
+	bValid = false;
+	bHasPrediction = false;
+	LastLatitude = 0.0f;
+	LastLongitude = 0.0f;
+	LastProgressOfYear = 0.0;
+	LastPolarCondition = 0;
+	SunLightDirection = FVector::ZeroVector;
+	MoonLightDirection = FVector::ZeroVector;
+	TimeSinceSolve = 0.0f;
+	TrackedAngle = 0.0f;
+}
+
+bool FAetherCelestialTracker::Advance(
+	float DeltaTime,
+	float Latitude,
+	float Longitude,
+	double ProgressOfYear,
+	int32 DaysPerYear,
+	float MaxTrackedAngle,
+	FVector& OutSunLightDirection,
+	FVector& OutMoonLightDirection)
+{
+	// The polar condition pins the sun, no rotation describes it.
+	if (!bValid || LastPolarCondition != 0)
+	{
+		return false;
+	}
+	
+	// Double, a tick at a low time scale is far below the float resolution of the year.
+	const double DeltaProgress = ProgressOfYear - LastProgressOfYear;
+	const float DeltaLongitude = FMath::DegreesToRadians(FMath::UnwindDegrees(Longitude - LastLongitude));
+	const float DeltaLatitude = FMath::DegreesToRadians(Latitude - LastLatitude);
+	const float SunAngle = (float)(DeltaProgress * (UE_DOUBLE_TWO_PI * DaysPerYear)) + DeltaLongitude;
+	const float MoonAngle = (float)(DeltaProgress * AetherCelestialTracker::MoonHourAngleRate) + DeltaLongitude;
+	// The moon turns several times faster than the sun on a short custom year, bound whichever turned most.
+	const float StepAngle = FMath::Max(FMath::Abs(SunAngle), FMath::Abs(MoonAngle)) + FMath::Abs(DeltaLatitude);
+	const float MaxAngle = FMath::DegreesToRadians(MaxTrackedAngle);
+	
+	// Wrapped year or time jump.
+	if (DeltaProgress < 0.0 || StepAngle > MaxAngle)
+	{
+		bValid = false;
+		bHasPrediction = false;
+		return false;
+	}
+	
+	// Local frame: X north, Y east, Z up. The celestial pole sits at elevation = latitude toward north.
+	float SinLat, CosLat;
+	FMath::SinCos(&SinLat, &CosLat, FMath::DegreesToRadians(LastLatitude));
+	const FVector PoleAxis(CosLat, 0.0f, SinLat);
+	// Moving north raises the pole, the whole sky turns around the east axis.
+	const FQuat LatitudeRotation(FVector::YAxisVector, -DeltaLatitude);
+	
+	SunLightDirection = LatitudeRotation.RotateVector(FQuat(PoleAxis, SunAngle).RotateVector(SunLightDirection));
+	MoonLightDirection = LatitudeRotation.RotateVector(FQuat(PoleAxis, MoonAngle).RotateVector(MoonLightDirection));
+	
+	LastLatitude = Latitude;
+	LastLongitude = Longitude;
+	LastProgressOfYear = ProgressOfYear;
+	TimeSinceSolve += DeltaTime;
+	TrackedAngle += StepAngle;
+	bHasPrediction = true;
+	
+	if (TimeSinceSolve >= CurrentInterval || TrackedAngle >= MaxAngle)
+	{
+		// Keep the prediction, the drift against the coming solve drives the interval.
+		return false;
+	}
+	
+	OutSunLightDirection = SunLightDirection;
+	OutMoonLightDirection = MoonLightDirection;
+	return true;
+}
+
+void FAetherCelestialTracker::Resync(
+	float Latitude,
+	float Longitude,
+	double ProgressOfYear,
+	int32 PolarCondition,
+	const FVector& InSunLightDirection,
+	const FVector& InMoonLightDirection,
+	float ResolveInterval,
+	float ErrorThreshold)
+{
+	if (bValid && bHasPrediction && PolarCondition == 0)
+	{
+		const float SunDrift = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(SunLightDirection, InSunLightDirection), -1.0, 1.0)));
+		const float MoonDrift = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(MoonLightDirection, InMoonLightDirection), -1.0, 1.0)));
+		LastDrift = FMath::Max(SunDrift, MoonDrift);
+		if (LastDrift > ErrorThreshold)
+		{
+			CurrentInterval = FMath::Max(CurrentInterval * 0.5f, AetherCelestialTracker::MinResolveInterval);
+		}
+		else
+		{
+			CurrentInterval = CurrentInterval * 1.5f;
+		}
+	}
+	else if (CurrentInterval <= 0.0f)
+	{
+		CurrentInterval = ResolveInterval;
+	}
+	CurrentInterval = FMath::Min(CurrentInterval, ResolveInterval);
+	
+	bValid = true;
+	bHasPrediction = false;
+	LastLatitude = Latitude;
+	LastLongitude = Longitude;
+	LastProgressOfYear = ProgressOfYear;
+	LastPolarCondition = PolarCondition;
+	SunLightDirection = InSunLightDirection;
+	MoonLightDirection = InMoonLightDirection;
+	TimeSinceSolve = 0.0f;
+	TrackedAngle = 0.0f;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherEphemerisSamples.h"
+
+#include "AetherWorldMath.inl"
+
+void FAetherEphemerisSamples::SetNum(int32 Num)
+{
+	Latitude.SetNumUninitialized(Num);
+	Longitude.SetNumUninitialized(Num);
+	TimeStampOfEarthDay.SetNumUninitialized(Num);
+	TimeStampOfEarthYear.SetNumUninitialized(Num);
+}
+
+void FAetherEphemerisSamples::InitRandom(int32 Num, int32 Seed)
+{
+	SetNum(Num);
+	FRandomStream Stream(Seed);
+	for (int32 i = 0; i < Num; i++)
+	{
+		Latitude[i] = Stream.FRandRange(-89.0f, 89.0f);
+		Longitude[i] = Stream.FRandRange(-180.0f, 180.0f);
+		TimeStampOfEarthDay[i] = Stream.FRandRange(0.0f, SECONDS_PER_DAY_EARTH);
+		TimeStampOfEarthYear[i] = Stream.FRandRange(0.0f, SECONDS_PER_YEAR_EARTH);
+	}
+}
+
+void FAetherEphemerisSamples::InitSweep(int32 LatitudeSteps, int32 LongitudeSteps, int32 DaySteps, int32 YearSteps)
+{
+	SetNum(LatitudeSteps * LongitudeSteps * DaySteps * YearSteps);
+	int32 Index = 0;
+	for (int32 LatitudeIndex = 0; LatitudeIndex < LatitudeSteps; LatitudeIndex++)
+	{
+		for (int32 LongitudeIndex = 0; LongitudeIndex < LongitudeSteps; LongitudeIndex++)
+		{
+			for (int32 DayIndex = 0; DayIndex < DaySteps; DayIndex++)
+			{
+				for (int32 YearIndex = 0; YearIndex < YearSteps; YearIndex++)
+				{
+					Latitude[Index] = FMath::Lerp(-89.0f, 89.0f, (LatitudeIndex + 0.5f) / LatitudeSteps);
+					Longitude[Index] = FMath::Lerp(-180.0f, 180.0f, (LongitudeIndex + 0.5f) / LongitudeSteps);
+					TimeStampOfEarthDay[Index] = (DayIndex + 0.5f) / DaySteps * SECONDS_PER_DAY_EARTH;
+					TimeStampOfEarthYear[Index] = (YearIndex + 0.5f) / YearSteps * SECONDS_PER_YEAR_EARTH;
+					Index++;
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherEphemerisTable.h"
+
+#include "AetherCelestialFrame.h"
+
+#include "AetherWorldMath.inl"
+
+void FAetherEphemerisTable::Build()
+{
+	// One extra entry so the last day interpolates towards the end of year.
+	Days.SetNumUninitialized(DAYS_PER_YEAR_EARTH + 1);
+	
+	float LastRightAscension = 0.0f;
+	for (int32 Day = 0; Day <= DAYS_PER_YEAR_EARTH; Day++)
+	{
+		FAetherEphemerisDay& Entry = Days[Day];
+		
+		const float SolarDeclination = CalculateSolarDeclination(Day);
+		FMath::SinCos(&Entry.SunSinDeclination, &Entry.SunCosDeclination, SolarDeclination);
+		
+		float RightAscension = 0.0f;
+		float Declination = 0.0f;
+		CalculateMoonEquatorialCoordinate(Day * SECONDS_PER_DAY_EARTH, RightAscension, Declination);
+		RightAscension = FMath::DegreesToRadians(RightAscension);
+		if (Day > 0)
+		{
+			// The moon advances about 13 degrees per day, always take the nearest branch.
+			RightAscension = LastRightAscension + FMath::UnwindRadians(RightAscension - LastRightAscension);
+		}
+		LastRightAscension = RightAscension;
+		Entry.MoonRightAscension = RightAscension;
+		FMath::SinCos(&Entry.MoonSinDeclination, &Entry.MoonCosDeclination, FMath::DegreesToRadians(Declination));
+		Entry.MoonEquatorialDirection = FAetherCelestialFrame::MakeEquatorialDirection(RightAscension, FMath::DegreesToRadians(Declination));
+	}
+}
+
+FAetherEphemerisDay FAetherEphemerisTable::Sample(float TimeStampOfEarthYear) const
+{
+	check(IsBuilt());
+	
+	const float DateOfYear = FMath::Clamp(TimeStampOfEarthYear / SECONDS_PER_DAY_EARTH, 0.0f, (float)DAYS_PER_YEAR_EARTH);
+	const int32 Day = FMath::Min(FMath::FloorToInt(DateOfYear), DAYS_PER_YEAR_EARTH - 1);
+	const float Alpha = DateOfYear - Day;
+	
+	const FAetherEphemerisDay& A = Days[Day];
+	const FAetherEphemerisDay& B = Days[Day + 1];
+	
+	FAetherEphemerisDay Result;
+	Result.SunSinDeclination = FMath::Lerp(A.SunSinDeclination, B.SunSinDeclination, Alpha);
+	Result.SunCosDeclination = FMath::Lerp(A.SunCosDeclination, B.SunCosDeclination, Alpha);
+	Result.MoonRightAscension = FMath::Lerp(A.MoonRightAscension, B.MoonRightAscension, Alpha);
+	Result.MoonSinDeclination = FMath::Lerp(A.MoonSinDeclination, B.MoonSinDeclination, Alpha);
+	Result.MoonCosDeclination = FMath::Lerp(A.MoonCosDeclination, B.MoonCosDeclination, Alpha);
+	Result.MoonEquatorialDirection = FMath::Lerp(A.MoonEquatorialDirection, B.MoonEquatorialDirection, Alpha);
+	return Result;
+}
+
+namespace AetherEphemerisTable
+{
+	template<typename MathPolicy>
+	void CalculatePlanetPosition(
+		const FAetherEphemerisDay& Ephemeris,
+		float Latitude,
+		float Longitude,
+		float TimeStampOfEarthDay,
+		float TimeStampOfEarthYear,
+		float& SunElevation,
+		float& SunAzimuth,
+		int32& PolarCondition,
+		float& MoonElevation,
+		float& MoonAzimuth)
+	{
+		float SinLat, CosLat;
+		MathPolicy::SinCos(&SinLat, &CosLat, FMath::DegreesToRadians(Latitude));
+		
+		// Sun hour angle: 15 * (LocalHour + (Longitude - 120) / 15 - 12).
+		const float SunHourAngleDeg = TimeStampOfEarthDay * (DEG_TO_HOUR / SECONDS_PER_HOUR) + Longitude - (STANDARD_MERIDIAN + DEG_TO_HOUR * 12.0f);
+		
+		// Moon hour angle: local sidereal time - right ascension, sidereal time reduced as in CalculateMoonPosition4.
+		const float DaysSince2000 = TimeStampOfEarthYear / SECONDS_PER_DAY_EARTH - 0.5f;
+		const float GreenwichSiderealTime = 280.46061837f + 360.0f * FMath::Frac(DaysSince2000) + 0.98564736629f * DaysSince2000;
+		const float MoonHourAngleRad = FMath::DegreesToRadians(GreenwichSiderealTime + Longitude) - Ephemeris.MoonRightAscension;
+		
+		// Lane 0: sun, lane 1: moon.
+		VectorRegister4Float Elevation, Azimuth;
+		CalculateHorizontalCoordinate4<MathPolicy>(
+			VectorSetFloat1(SinLat),
+			VectorSetFloat1(CosLat),
+			MakeVectorRegisterFloat(Ephemeris.SunSinDeclination, Ephemeris.MoonSinDeclination, 0.0f, 0.0f),
+			MakeVectorRegisterFloat(Ephemeris.SunCosDeclination, Ephemeris.MoonCosDeclination, 1.0f, 1.0f),
+			MakeVectorRegisterFloat(FMath::DegreesToRadians(SunHourAngleDeg), MoonHourAngleRad, 0.0f, 0.0f),
+			Elevation,
+			Azimuth);
+		
+		float ElevationLanes[4];
+		float AzimuthLanes[4];
+		VectorStore(Elevation, ElevationLanes);
+		VectorStore(Azimuth, AzimuthLanes);
+		
+		SunElevation = ElevationLanes[0];
+		SunAzimuth = AzimuthLanes[0];
+		MoonElevation = ElevationLanes[1];
+		MoonAzimuth = AzimuthLanes[1];
+		
+		// Polar day / polar night.
+		const float CriticalAngleCos = -SinLat * Ephemeris.SunSinDeclination / (CosLat * Ephemeris.SunCosDeclination);
+		PolarCondition = 0;
+		if (CriticalAngleCos > 1.0f)
+		{
+			PolarCondition = -1;
+			SunElevation = -90.0f;
+		}
+		else if (CriticalAngleCos < -1.0f)
+		{
+			PolarCondition = 1;
+			SunElevation = 90.0f;
+		}
+	}
+}
+
+void FAetherEphemerisTable::CalculatePlanetPosition(
+	float Latitude,
+	float Longitude,
+	float TimeStampOfEarthDay,
+	float TimeStampOfEarthYear,
+	float& SunElevation,
+	float& SunAzimuth,
+	int32& PolarCondition,
+	float& MoonElevation,
+	float& MoonAzimuth,
+	bool bFastMath) const
+{
+	const FAetherEphemerisDay Ephemeris = Sample(TimeStampOfEarthYear);
+	if (bFastMath)
+	{
+		AetherEphemerisTable::CalculatePlanetPosition<FAetherFastMath>(Ephemeris, Latitude, Longitude, TimeStampOfEarthDay, TimeStampOfEarthYear, SunElevation, SunAzimuth, PolarCondition, MoonElevation, MoonAzimuth);
+	}
+	else
+	{
+		AetherEphemerisTable::CalculatePlanetPosition<FAetherPreciseMath>(Ephemeris, Latitude, Longitude, TimeStampOfEarthDay, TimeStampOfEarthYear, SunElevation, SunAzimuth, PolarCondition, MoonElevation, MoonAzimuth);
+	}
+}
+
+void FAetherEphemerisTable::CalculatePlanetDirection(
+	const FAetherCelestialFrame& Frame,
+	float TimeStampOfEarthYear,
+	FVector3f& SunDirection,
+	int32& PolarCondition,
+	FVector3f& MoonDirection) const
+{
+	const FAetherEphemerisDay Ephemeris = Sample(TimeStampOfEarthYear);
+	
+	SunDirection = Frame.GetSunDirection(Ephemeris.SunSinDeclination, Ephemeris.SunCosDeclination);
+	// Chord of about 13 degrees between two days, renormalize.
+	MoonDirection = Frame.TransformEquatorial(Ephemeris.MoonEquatorialDirection.GetUnsafeNormal());
+	
+	// Polar day / polar night, the sun is pinned as CalculateSunPosition does.
+	const float CriticalAngleCos = -Frame.GetSinLatitude() * Ephemeris.SunSinDeclination / (Frame.GetCosLatitude() * Ephemeris.SunCosDeclination);
+	PolarCondition = 0;
+	if (CriticalAngleCos > 1.0f)
+	{
+		PolarCondition = -1;
+		SunDirection = FVector3f(0.0f, 0.0f, -1.0f);
+	}
+	else if (CriticalAngleCos < -1.0f)
+	{
+		PolarCondition = 1;
+		SunDirection = FVector3f(0.0f, 0.0f, 1.0f);
+	}
+}
\ No newline at end of file
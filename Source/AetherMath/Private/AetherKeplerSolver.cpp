@@ -0,0 +1,146 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherKeplerSolver.h"
+
+#include "AetherWorldMath.inl"
+
+void FAetherKeplerSolver::Initialize(TConstArrayView<FAetherOrbitalElements> Elements)
+{
+	NumBodies = Elements.Num();
+	bWarmStart = false;
+	
+	// Padding lanes are circular orbits of zero size, they solve to zero without branching.
+	const int32 NumPadded = Align(NumBodies, 4);
+	MeanAnomalyAtEpoch.SetNumZeroed(NumPadded);
+	MeanMotion.SetNumZeroed(NumPadded);
+	Eccentricity.SetNumZeroed(NumPadded);
+	SemiMajorAxis.SetNumZeroed(NumPadded);
+	SemiMinorAxis.SetNumZeroed(NumPadded);
+	PX.SetNumZeroed(NumPadded);
+	PY.SetNumZeroed(NumPadded);
+	PZ.SetNumZeroed(NumPadded);
+	QX.SetNumZeroed(NumPadded);
+	QY.SetNumZeroed(NumPadded);
+	QZ.SetNumZeroed(NumPadded);
+	MeanAnomaly.SetNumZeroed(NumPadded);
+	EccentricAnomaly.SetNumZeroed(NumPadded);
+	AnomalyOffset.SetNumZeroed(NumPadded);
+	PositionX.SetNumZeroed(NumPadded);
+	PositionY.SetNumZeroed(NumPadded);
+	PositionZ.SetNumZeroed(NumPadded);
+	
+	for (int32 Index = 0; Index < NumBodies; Index++)
+	{
+		const FAetherOrbitalElements& Element = Elements[Index];
+		const float Eccentric = FMath::Clamp(Element.Eccentricity, 0.0f, 0.99f);
+		
+		MeanAnomalyAtEpoch[Index] = FMath::DegreesToRadians((double)Element.MeanAnomalyAtEpoch);
+		MeanMotion[Index] = UE_DOUBLE_TWO_PI / FMath::Max((double)Element.OrbitalPeriod, UE_DOUBLE_KINDA_SMALL_NUMBER);
+		Eccentricity[Index] = Eccentric;
+		SemiMajorAxis[Index] = Element.SemiMajorAxis;
+		SemiMinorAxis[Index] = Element.SemiMajorAxis * FMath::Sqrt(1.0f - Eccentric * Eccentric);
+		
+		float SinNode, CosNode, SinPeriapsis, CosPeriapsis, SinInclination, CosInclination;
+		FMath::SinCos(&SinNode, &CosNode, FMath::DegreesToRadians(Element.LongitudeOfAscendingNode));
+		FMath::SinCos(&SinPeriapsis, &CosPeriapsis, FMath::DegreesToRadians(Element.ArgumentOfPeriapsis));
+		FMath::SinCos(&SinInclination, &CosInclination, FMath::DegreesToRadians(Element.Inclination));
+		
+		// Rz(Ω)·Rx(i)·Rz(ω) applied to the perifocal X and Y axes.
+		PX[Index] = CosNode * CosPeriapsis - SinNode * SinPeriapsis * CosInclination;
+		PY[Index] = SinNode * CosPeriapsis + CosNode * SinPeriapsis * CosInclination;
+		PZ[Index] = SinPeriapsis * SinInclination;
+		QX[Index] = -CosNode * SinPeriapsis - SinNode * CosPeriapsis * CosInclination;
+		QY[Index] = -SinNode * SinPeriapsis + CosNode * CosPeriapsis * CosInclination;
+		QZ[Index] = CosPeriapsis * SinInclination;
+	}
+}
+
+int32 FAetherKeplerSolver::Solve(double Time, bool bFastMath)
+{
+	if (NumBodies == 0)
+	{
+		return 0;
+	}
+	
+	// Reduce in double, the float lanes only ever see [-π, π).
+	for (int32 Index = 0; Index < NumBodies; Index++)
+	{
+		double Anomaly = FMath::Fmod(MeanAnomalyAtEpoch[Index] + MeanMotion[Index] * Time, UE_DOUBLE_TWO_PI);
+		Anomaly += Anomaly < -UE_DOUBLE_PI ? UE_DOUBLE_TWO_PI : (Anomaly >= UE_DOUBLE_PI ? -UE_DOUBLE_TWO_PI : 0.0);
+		MeanAnomaly[Index] = (float)Anomaly;
+	}
+	
+	const int32 Iterations = bFastMath ? SolveInternal<FAetherFastMath>(FastMathTolerance) : SolveInternal<FAetherPreciseMath>(Tolerance);
+	bWarmStart = true;
+	return Iterations;
+}
+
+template<typename MathPolicy>
+int32 FAetherKeplerSolver::SolveInternal(float StepTolerance)
+{
+	const int32 NumPadded = Eccentricity.Num();
+	
+	for (int32 Index = 0; Index < NumPadded; Index += 4)
+	{
+		const VectorRegister4Float M = VectorLoad(&MeanAnomaly[Index]);
+		VectorRegister4Float Start;
+		if (bWarmStart)
+		{
+			Start = VectorAdd(M, VectorLoad(&AnomalyOffset[Index]));
+		}
+		else
+		{
+			// Danby's starter E0 = M + 0.85·e·sign(sin M), converges for every e < 1.
+			const VectorRegister4Float Sign = VectorSelect(VectorCompareLT(M, GlobalVectorConstants::FloatZero), GlobalVectorConstants::FloatMinusOne, GlobalVectorConstants::FloatOne);
+			Start = VectorMultiplyAdd(VectorMultiply(VectorLoad(&Eccentricity[Index]), VectorSetFloat1(0.85f)), Sign, M);
+		}
+		VectorStore(Start, &EccentricAnomaly[Index]);
+	}
+	
+	// Newton on f(E) = E - e·sin(E) - M, one pass over all bodies per step.
+	const VectorRegister4Float ToleranceRegister = VectorSetFloat1(StepTolerance);
+	int32 Iteration = 0;
+	while (Iteration < MaxIterations)
+	{
+		Iteration++;
+		VectorRegister4Float MaxStep = GlobalVectorConstants::FloatZero;
+		for (int32 Index = 0; Index < NumPadded; Index += 4)
+		{
+			const VectorRegister4Float E = VectorLoad(&EccentricAnomaly[Index]);
+			const VectorRegister4Float Eccentric = VectorLoad(&Eccentricity[Index]);
+			VectorRegister4Float SinE, CosE;
+			MathPolicy::VectorSinCos(&SinE, &CosE, &E);
+			
+			const VectorRegister4Float F = VectorSubtract(VectorNegateMultiplyAdd(Eccentric, SinE, E), VectorLoad(&MeanAnomaly[Index]));
+			const VectorRegister4Float FPrime = VectorNegateMultiplyAdd(Eccentric, CosE, GlobalVectorConstants::FloatOne);
+			const VectorRegister4Float Step = VectorDivide(F, FPrime);
+			VectorStore(VectorSubtract(E, Step), &EccentricAnomaly[Index]);
+			MaxStep = VectorMax(MaxStep, VectorAbs(Step));
+		}
+		if (!VectorAnyGreaterThan(MaxStep, ToleranceRegister))
+		{
+			break;
+		}
+	}
+	
+	// Perifocal x = a·(cos E - e), y = b·sin E, then into the reference frame.
+	for (int32 Index = 0; Index < NumPadded; Index += 4)
+	{
+		const VectorRegister4Float E = VectorLoad(&EccentricAnomaly[Index]);
+		const VectorRegister4Float Eccentric = VectorLoad(&Eccentricity[Index]);
+		VectorRegister4Float SinE, CosE;
+		MathPolicy::VectorSinCos(&SinE, &CosE, &E);
+		
+		const VectorRegister4Float X = VectorMultiply(VectorLoad(&SemiMajorAxis[Index]), VectorSubtract(CosE, Eccentric));
+		const VectorRegister4Float Y = VectorMultiply(VectorLoad(&SemiMinorAxis[Index]), SinE);
+		VectorStore(VectorMultiplyAdd(X, VectorLoad(&PX[Index]), VectorMultiply(Y, VectorLoad(&QX[Index]))), &PositionX[Index]);
+		VectorStore(VectorMultiplyAdd(X, VectorLoad(&PY[Index]), VectorMultiply(Y, VectorLoad(&QY[Index]))), &PositionY[Index]);
+		VectorStore(VectorMultiplyAdd(X, VectorLoad(&PZ[Index]), VectorMultiply(Y, VectorLoad(&QZ[Index]))), &PositionZ[Index]);
+		VectorStore(VectorSubtract(E, VectorLoad(&MeanAnomaly[Index])), &AnomalyOffset[Index]);
+	}
+	
+	return Iteration;
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherMath.h"
+
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY(LogAetherMath);
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, AetherMath)
\ No newline at end of file
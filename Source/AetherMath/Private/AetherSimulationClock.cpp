@@ -0,0 +1,79 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherSimulationClock.h"
+
+#include "AetherWorldMath.inl"
+
+namespace AetherSimulationClock
+{
+	/**
+	 * Splits Seconds plus the carried fraction into whole ticks, keeps the new fraction in Remainder.
+	 */
+	static int64 ConsumeTicks(double Seconds, double& Remainder)
+	{
+		const double Ticks = Seconds * FAetherSimulationClock::TicksPerSecond + Remainder;
+		const double WholeTicks = FMath::FloorToDouble(Ticks);
+		Remainder = Ticks - WholeTicks;
+		return (int64)WholeTicks;
+	}
+}
+
+FAetherSimulationClock::FAetherSimulationClock()
+{
+	Initialize(DAYS_PER_YEAR_EARTH);
+}
+
+void FAetherSimulationClock::Initialize(int32 InDaysPerYear, double ProgressOfYear)
+{
+	DaysPerYear = FMath::Max(InDaysPerYear, 1);
+	TicksPerYear = DaysPerYear * TicksPerDay;
+	Year = 0;
+	TickOfYear = FMath::Clamp((int64)(FMath::Frac(ProgressOfYear) * TicksPerYear), (int64)0, TicksPerYear - 1);
+	ElapsedTicks = 0;
+	SubTickRemainder = 0.0;
+	ElapsedSubTickRemainder = 0.0;
+}
+
+int64 FAetherSimulationClock::Advance(double SimulatedSeconds, double RealSeconds)
+{
+	ElapsedTicks += AetherSimulationClock::ConsumeTicks(RealSeconds, ElapsedSubTickRemainder);
+	
+	// Whole years first, the remaining part then always fits the tick range.
+	const double SecondsPerYear = (double)TicksPerYear / TicksPerSecond;
+	const double WholeYears = FMath::FloorToDouble(SimulatedSeconds / SecondsPerYear);
+	const int64 PreviousYear = Year;
+	Year += (int64)WholeYears;
+	TickOfYear += AetherSimulationClock::ConsumeTicks(SimulatedSeconds - WholeYears * SecondsPerYear, SubTickRemainder);
+	
+	while (TickOfYear >= TicksPerYear)
+	{
+		TickOfYear -= TicksPerYear;
+		Year++;
+	}
+	while (TickOfYear < 0)
+	{
+		TickOfYear += TicksPerYear;
+		Year--;
+	}
+	return Year - PreviousYear;
+}
+
+void FAetherSimulationClock::SetTime(int64 InYear, int64 InTickOfYear)
+{
+	Year = InYear + InTickOfYear / TicksPerYear;
+	TickOfYear = InTickOfYear % TicksPerYear;
+	if (TickOfYear < 0)
+	{
+		TickOfYear += TicksPerYear;
+		Year--;
+	}
+	SubTickRemainder = 0.0;
+}
+
+float FAetherSimulationClock::GetTimeStampOfEarthYear() const
+{
+	return (float)(GetProgressOfYear() * SECONDS_PER_YEAR_EARTH);
+}
\ No newline at end of file
@@ -0,0 +1,379 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherMath.h"
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+
+#include "AetherCelestialFrame.h"
+#include "AetherEphemerisSamples.h"
+#include "AetherEphemerisTable.h"
+#include "AetherKeplerSolver.h"
+
+#include "AetherWorldMath.inl"
+
+namespace AetherWorldMathBenchmark
+{
+	/**
+	 * at.Benchmark.Ephemeris [NumPoints] [Iterations]
+	 * Compares per-point cost of the scalar sun/moon solve against the batched SIMD kernel, the per-day table and the light direction conversion.
+	 */
+	static void RunEphemerisBenchmark(const TArray<FString>& Args)
+	{
+		const int32 Num = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 4096;
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 64;
+		
+		FAetherEphemerisSamples Input;
+		Input.InitRandom(Num);
+		
+		TArray<float> Elevation, Azimuth;
+		TArray<int32> PolarCondition;
+		Elevation.SetNumZeroed(Num);
+		Azimuth.SetNumZeroed(Num);
+		PolarCondition.SetNumZeroed(Num);
+		
+		TArray<float> BatchElevation, BatchAzimuth;
+		BatchElevation.SetNumZeroed(Num);
+		BatchAzimuth.SetNumZeroed(Num);
+		
+		const double PointCount = double(Num) * Iterations;
+		
+		// Sun
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (int32 i = 0; i < Num; i++)
+			{
+				CalculateSunPosition(Input.Latitude[i], Input.Longitude[i], Input.TimeStampOfEarthDay[i], Input.TimeStampOfEarthYear[i], Elevation[i], Azimuth[i], PolarCondition[i]);
+			}
+		}
+		const double SunScalarTime = FPlatformTime::Seconds() - StartTime;
+		
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			CalculateSunPositionBatch(Input.Latitude.GetData(), Input.Longitude.GetData(), Input.TimeStampOfEarthDay.GetData(), Input.TimeStampOfEarthYear.GetData(), BatchElevation.GetData(), BatchAzimuth.GetData(), PolarCondition.GetData(), Num);
+		}
+		const double SunBatchTime = FPlatformTime::Seconds() - StartTime;
+		
+		float SunMaxError = 0.0f;
+		for (int32 i = 0; i < Num; i++)
+		{
+			const FVector Scalar = ConvertPlanetDirection(Elevation[i], Azimuth[i]);
+			const FVector Batch = ConvertPlanetDirection(BatchElevation[i], BatchAzimuth[i]);
+			SunMaxError = FMath::Max(SunMaxError, FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(Scalar, Batch), -1.0, 1.0))));
+		}
+		
+		// Moon
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (int32 i = 0; i < Num; i++)
+			{
+				CalculateMoonPosition(Input.Latitude[i], Input.Longitude[i], Input.TimeStampOfEarthDay[i], Input.TimeStampOfEarthYear[i], Elevation[i], Azimuth[i]);
+			}
+		}
+		const double MoonScalarTime = FPlatformTime::Seconds() - StartTime;
+		
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			CalculateMoonPositionBatch(Input.Latitude.GetData(), Input.Longitude.GetData(), Input.TimeStampOfEarthDay.GetData(), Input.TimeStampOfEarthYear.GetData(), BatchElevation.GetData(), BatchAzimuth.GetData(), Num);
+		}
+		const double MoonBatchTime = FPlatformTime::Seconds() - StartTime;
+		
+		float MoonMaxError = 0.0f;
+		for (int32 i = 0; i < Num; i++)
+		{
+			const FVector Scalar = ConvertPlanetDirection(Elevation[i], Azimuth[i]);
+			const FVector Batch = ConvertPlanetDirection(BatchElevation[i], BatchAzimuth[i]);
+			MoonMaxError = FMath::Max(MoonMaxError, FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(Scalar, Batch), -1.0, 1.0))));
+		}
+		
+		// Per-day table, sun and moon together.
+		FAetherEphemerisTable Table;
+		Table.Build();
+		float MoonElevation = 0.0f;
+		float MoonAzimuth = 0.0f;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (int32 i = 0; i < Num; i++)
+			{
+				Table.CalculatePlanetPosition(Input.Latitude[i], Input.Longitude[i], Input.TimeStampOfEarthDay[i], Input.TimeStampOfEarthYear[i], Elevation[i], Azimuth[i], PolarCondition[i], MoonElevation, MoonAzimuth);
+			}
+		}
+		const double TableTime = FPlatformTime::Seconds() - StartTime;
+		
+		// Celestial frame, built per point here so the build cost is included, directions come out without conversion.
+		FAetherCelestialFrame Frame;
+		FVector3f FrameDirectionSum = FVector3f::ZeroVector;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (int32 i = 0; i < Num; i++)
+			{
+				FVector3f SunDirection, MoonDirection;
+				Frame.Build(Input.Latitude[i], Input.Longitude[i], Input.TimeStampOfEarthDay[i], Input.TimeStampOfEarthYear[i]);
+				Table.CalculatePlanetDirection(Frame, Input.TimeStampOfEarthYear[i], SunDirection, PolarCondition[i], MoonDirection);
+				FrameDirectionSum += SunDirection + MoonDirection;
+			}
+		}
+		const double FrameTime = FPlatformTime::Seconds() - StartTime;
+		
+		// Catalog through one frame, e.g. a star field.
+		TArray<FVector3f> CatalogDirection, HorizonDirection;
+		CatalogDirection.SetNumUninitialized(Num);
+		HorizonDirection.SetNumUninitialized(Num);
+		for (int32 i = 0; i < Num; i++)
+		{
+			CatalogDirection[i] = FAetherCelestialFrame::MakeEquatorialDirection(FMath::DegreesToRadians(Input.Longitude[i] + 180.0f), FMath::DegreesToRadians(Input.Latitude[i]));
+		}
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Frame.TransformEquatorial(CatalogDirection.GetData(), HorizonDirection.GetData(), Num);
+			FrameDirectionSum += HorizonDirection[Iteration % Num];
+		}
+		const double CatalogTime = FPlatformTime::Seconds() - StartTime;
+		
+		// Kepler orbits stepped like a tick sequence, warm started after the first solve.
+		TArray<FAetherOrbitalElements> Elements;
+		Elements.SetNum(Num);
+		for (int32 i = 0; i < Num; i++)
+		{
+			Elements[i].Eccentricity = FMath::Abs(Input.Latitude[i]) / 100.0f;
+			Elements[i].MeanAnomalyAtEpoch = Input.Longitude[i];
+			Elements[i].OrbitalPeriod = 1.0f + Input.TimeStampOfEarthYear[i] / SECONDS_PER_DAY_EARTH;
+		}
+		FAetherKeplerSolver KeplerSolver;
+		KeplerSolver.Initialize(Elements);
+		int32 KeplerIterations = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			KeplerIterations += KeplerSolver.Solve(Iteration * 0.0015);
+		}
+		const double KeplerTime = FPlatformTime::Seconds() - StartTime;
+		
+		// Elevation/azimuth to light direction, summed so the loop is not optimized away.
+		FVector DirectionSum = FVector::ZeroVector;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (int32 i = 0; i < Num; i++)
+			{
+				DirectionSum += ConvertPlanetLightDirection(Elevation[i], Azimuth[i]);
+			}
+		}
+		const double LightDirectionTime = FPlatformTime::Seconds() - StartTime;
+		
+		UE_LOG(LogAetherMath, Display, TEXT("Ephemeris benchmark: %d points x %d iterations."), Num, Iterations);
+		UE_LOG(LogAetherMath, Display, TEXT("  Sun  scalar: %8.2f ns/point, batch: %8.2f ns/point, speedup: %5.2fx, max deviation: %.4f deg"),
+			SunScalarTime * 1.0e9 / PointCount, SunBatchTime * 1.0e9 / PointCount, SunScalarTime / FMath::Max(SunBatchTime, UE_DOUBLE_SMALL_NUMBER), SunMaxError);
+		UE_LOG(LogAetherMath, Display, TEXT("  Moon scalar: %8.2f ns/point, batch: %8.2f ns/point, speedup: %5.2fx, max deviation: %.4f deg"),
+			MoonScalarTime * 1.0e9 / PointCount, MoonBatchTime * 1.0e9 / PointCount, MoonScalarTime / FMath::Max(MoonBatchTime, UE_DOUBLE_SMALL_NUMBER), MoonMaxError);
+		UE_LOG(LogAetherMath, Display, TEXT("  Sun + Moon per-day table: %8.2f ns/point"), TableTime * 1.0e9 / PointCount);
+		UE_LOG(LogAetherMath, Display, TEXT("  Sun + Moon celestial frame: %8.2f ns/point, catalog transform: %8.2f ns/body (checksum %s)"),
+			FrameTime * 1.0e9 / PointCount, CatalogTime * 1.0e9 / PointCount, *FrameDirectionSum.ToString());
+		UE_LOG(LogAetherMath, Display, TEXT("  Kepler solve: %8.2f ns/body, %.2f Newton steps per solve"), KeplerTime * 1.0e9 / PointCount, (float)KeplerIterations / Iterations);
+		UE_LOG(LogAetherMath, Display, TEXT("  Light direction conversion: %8.2f ns/point (checksum %s)"), LightDirectionTime * 1.0e9 / PointCount, *DirectionSum.ToString());
+	}
+	
+	struct FAngularError
+	{
+		float Max = 0.0f;
+		double Sum = 0.0;
+		int32 Count = 0;
+		int32 Skipped = 0;
+		
+		void Add(float ReferenceElevation, float ReferenceAzimuth, float Elevation, float Azimuth)
+		{
+			const FVector Reference = ConvertPlanetDirection(ReferenceElevation, ReferenceAzimuth);
+			const FVector Test = ConvertPlanetDirection(Elevation, Azimuth);
+			const float Error = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(Reference, Test), -1.0, 1.0)));
+			Max = FMath::Max(Max, Error);
+			Sum += Error;
+			Count++;
+		}
+		
+		float Mean() const { return Count > 0 ? Sum / Count : 0.0f; }
+	};
+	
+	template<typename FunctionType>
+	static double MeasureSeconds(int32 Iterations, FunctionType&& Function)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Function();
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+	
+	/**
+	 * at.Math.Validate [LatitudeSteps] [LongitudeSteps] [DaySteps] [YearSteps] [Iterations]
+	 * Sweeps the input space and reports the angular error of FAetherFastMath against FAetherPreciseMath, and the throughput of both.
+	 * Points where the two paths disagree on the polar condition are counted apart, they pin the sun to +-90 degree.
+	 */
+	static void RunMathValidation(const TArray<FString>& Args)
+	{
+		const int32 LatitudeSteps = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 19;
+		const int32 LongitudeSteps = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 13;
+		const int32 DaySteps = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 24;
+		const int32 YearSteps = Args.Num() > 3 ? FMath::Max(FCString::Atoi(*Args[3]), 1) : 12;
+		const int32 Iterations = Args.Num() > 4 ? FMath::Max(FCString::Atoi(*Args[4]), 1) : 8;
+		
+		FAetherEphemerisSamples Input;
+		Input.InitSweep(LatitudeSteps, LongitudeSteps, DaySteps, YearSteps);
+		const int32 Num = Input.Num();
+		const double PointCount = double(Num) * Iterations;
+		
+		TArray<float> ReferenceElevation, ReferenceAzimuth, Elevation, Azimuth;
+		TArray<int32> ReferencePolarCondition, PolarCondition;
+		ReferenceElevation.SetNumZeroed(Num);
+		ReferenceAzimuth.SetNumZeroed(Num);
+		Elevation.SetNumZeroed(Num);
+		Azimuth.SetNumZeroed(Num);
+		ReferencePolarCondition.SetNumZeroed(Num);
+		PolarCondition.SetNumZeroed(Num);
+		
+		const float* Latitude = Input.Latitude.GetData();
+		const float* Longitude = Input.Longitude.GetData();
+		const float* TimeStampOfEarthDay = Input.TimeStampOfEarthDay.GetData();
+		const float* TimeStampOfEarthYear = Input.TimeStampOfEarthYear.GetData();
+		
+		UE_LOG(LogAetherMath, Display, TEXT("Math validation: %d points x %d iterations, fast path against precise path."), Num, Iterations);
+		
+		auto Report = [&](const TCHAR* Name, double PreciseTime, double FastTime, const FAngularError& Error)
+		{
+			UE_LOG(LogAetherMath, Display, TEXT("  %-12s precise: %8.2f ns/point, fast: %8.2f ns/point, speedup: %5.2fx, error max: %.5f deg, mean: %.6f deg, polar mismatch: %d"),
+				Name, PreciseTime * 1.0e9 / PointCount, FastTime * 1.0e9 / PointCount, PreciseTime / FMath::Max(FastTime, UE_DOUBLE_SMALL_NUMBER), Error.Max, Error.Mean(), Error.Skipped);
+		};
+		
+		auto CompareSun = [&]()
+		{
+			FAngularError Error;
+			for (int32 i = 0; i < Num; i++)
+			{
+				if (ReferencePolarCondition[i] != PolarCondition[i])
+				{
+					Error.Skipped++;
+					continue;
+				}
+				Error.Add(ReferenceElevation[i], ReferenceAzimuth[i], Elevation[i], Azimuth[i]);
+			}
+			return Error;
+		};
+		
+		auto CompareMoon = [&]()
+		{
+			FAngularError Error;
+			for (int32 i = 0; i < Num; i++)
+			{
+				Error.Add(ReferenceElevation[i], ReferenceAzimuth[i], Elevation[i], Azimuth[i]);
+			}
+			return Error;
+		};
+		
+		// Scalar sun
+		{
+			const double PreciseTime = MeasureSeconds(Iterations, [&]()
+			{
+				for (int32 i = 0; i < Num; i++)
+				{
+					CalculateSunPosition<FAetherPreciseMath>(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], ReferenceElevation[i], ReferenceAzimuth[i], ReferencePolarCondition[i]);
+				}
+			});
+			const double FastTime = MeasureSeconds(Iterations, [&]()
+			{
+				for (int32 i = 0; i < Num; i++)
+				{
+					CalculateSunPosition<FAetherFastMath>(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], Elevation[i], Azimuth[i], PolarCondition[i]);
+				}
+			});
+			Report(TEXT("Sun scalar"), PreciseTime, FastTime, CompareSun());
+		}
+		
+		// Batched sun
+		{
+			const double PreciseTime = MeasureSeconds(Iterations, [&]()
+			{
+				CalculateSunPositionBatch<FAetherPreciseMath>(Latitude, Longitude, TimeStampOfEarthDay, TimeStampOfEarthYear, ReferenceElevation.GetData(), ReferenceAzimuth.GetData(), ReferencePolarCondition.GetData(), Num);
+			});
+			const double FastTime = MeasureSeconds(Iterations, [&]()
+			{
+				CalculateSunPositionBatch<FAetherFastMath>(Latitude, Longitude, TimeStampOfEarthDay, TimeStampOfEarthYear, Elevation.GetData(), Azimuth.GetData(), PolarCondition.GetData(), Num);
+			});
+			Report(TEXT("Sun batch"), PreciseTime, FastTime, CompareSun());
+		}
+		
+		// Scalar moon
+		{
+			const double PreciseTime = MeasureSeconds(Iterations, [&]()
+			{
+				for (int32 i = 0; i < Num; i++)
+				{
+					CalculateMoonPosition<FAetherPreciseMath>(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], ReferenceElevation[i], ReferenceAzimuth[i]);
+				}
+			});
+			const double FastTime = MeasureSeconds(Iterations, [&]()
+			{
+				for (int32 i = 0; i < Num; i++)
+				{
+					CalculateMoonPosition<FAetherFastMath>(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], Elevation[i], Azimuth[i]);
+				}
+			});
+			Report(TEXT("Moon scalar"), PreciseTime, FastTime, CompareMoon());
+		}
+		
+		// Batched moon
+		{
+			const double PreciseTime = MeasureSeconds(Iterations, [&]()
+			{
+				CalculateMoonPositionBatch<FAetherPreciseMath>(Latitude, Longitude, TimeStampOfEarthDay, TimeStampOfEarthYear, ReferenceElevation.GetData(), ReferenceAzimuth.GetData(), Num);
+			});
+			const double FastTime = MeasureSeconds(Iterations, [&]()
+			{
+				CalculateMoonPositionBatch<FAetherFastMath>(Latitude, Longitude, TimeStampOfEarthDay, TimeStampOfEarthYear, Elevation.GetData(), Azimuth.GetData(), Num);
+			});
+			Report(TEXT("Moon batch"), PreciseTime, FastTime, CompareMoon());
+		}
+		
+		// Per-day table, the path used by the subsystem. Sun is compared, moon rides in the same SIMD pass.
+		{
+			FAetherEphemerisTable Table;
+			Table.Build();
+			float MoonElevation = 0.0f;
+			float MoonAzimuth = 0.0f;
+			const double PreciseTime = MeasureSeconds(Iterations, [&]()
+			{
+				for (int32 i = 0; i < Num; i++)
+				{
+					Table.CalculatePlanetPosition(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], ReferenceElevation[i], ReferenceAzimuth[i], ReferencePolarCondition[i], MoonElevation, MoonAzimuth, false);
+				}
+			});
+			const double FastTime = MeasureSeconds(Iterations, [&]()
+			{
+				for (int32 i = 0; i < Num; i++)
+				{
+					Table.CalculatePlanetPosition(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], Elevation[i], Azimuth[i], PolarCondition[i], MoonElevation, MoonAzimuth, true);
+				}
+			});
+			Report(TEXT("Table"), PreciseTime, FastTime, CompareSun());
+		}
+	}
+	
+	static FAutoConsoleCommand CmdMathValidation(
+		TEXT("at.Math.Validate"),
+		TEXT("Sweep lat/lon/time and report error and throughput of the fast math path against the precise one. Usage: at.Math.Validate [LatitudeSteps] [LongitudeSteps] [DaySteps] [YearSteps] [Iterations]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunMathValidation));
+	
+	static FAutoConsoleCommand CmdEphemerisBenchmark(
+		TEXT("at.Benchmark.Ephemeris"),
+		TEXT("Measure per-point cost of the scalar and batched sun/moon position solvers. Usage: at.Benchmark.Ephemeris [NumPoints] [Iterations]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunEphemerisBenchmark));
+}
\ No newline at end of file
@@ -0,0 +1,322 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "AetherMathVerification.h"
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+
+#include "AetherCelestialFrame.h"
+#include "AetherEphemerisSamples.h"
+#include "AetherEphemerisTable.h"
+#include "AetherKeplerSolver.h"
+#include "AetherMath.h"
+#include "AetherSimulationClock.h"
+
+#include "AetherWorldMath.inl"
+
+void FAetherMathVerification::VerifyAll()
+{
+	VerifyAlmanac();
+	VerifyConsistency();
+	VerifyKepler();
+	VerifyClock();
+}
+
+int32 FAetherMathVerification::GetNumFailed() const
+{
+	int32 NumFailed = 0;
+	for (const FAetherMathCheck& Check : Checks)
+	{
+		NumFailed += Check.IsPassed() ? 0 : 1;
+	}
+	return NumFailed;
+}
+
+void FAetherMathVerification::Expect(const TCHAR* Name, float Value, float Expected, float Tolerance)
+{
+	Checks.Add({ Name, Value, Expected, FMath::Abs(Value - Expected), Tolerance });
+}
+
+void FAetherMathVerification::ExpectAngle(const TCHAR* Name, float Value, float Expected, float Tolerance)
+{
+	Checks.Add({ Name, Value, Expected, FMath::Abs(FMath::FindDeltaAngleDegrees(Expected, Value)), Tolerance });
+}
+
+void FAetherMathVerification::ExpectBelow(const TCHAR* Name, float Value, float Limit)
+{
+	Checks.Add({ Name, Value, 0.0f, Value, Limit });
+}
+
+static float SecondsOfDate(float DayOfYear, float Hour)
+{
+	return DayOfYear * SECONDS_PER_DAY_EARTH + Hour * SECONDS_PER_HOUR;
+}
+
+/**
+ * Almanac values the simplified model is expected to reproduce.
+ * Solar noon is taken at the standard meridian so the equation of time, not modelled, does not enter.
+ */
+void FAetherMathVerification::VerifyAlmanac()
+{
+	float Elevation, Azimuth;
+	int32 PolarCondition;
+	
+	// Beijing, 39.9N. Noon elevation = 90 - latitude + declination.
+	CalculateSunPosition(39.9f, STANDARD_MERIDIAN, 12.0f * SECONDS_PER_HOUR, SecondsOfDate(172.0f, 0.0f), Elevation, Azimuth, PolarCondition);
+	Expect(TEXT("Sun noon elevation, 39.9N, June solstice"), Elevation, 73.54f, 0.25f);
+	ExpectAngle(TEXT("Sun noon azimuth, 39.9N, June solstice"), Azimuth, 180.0f, 0.1f);
+	CalculateSunPosition(39.9f, STANDARD_MERIDIAN, 12.0f * SECONDS_PER_HOUR, SecondsOfDate(355.0f, 0.0f), Elevation, Azimuth, PolarCondition);
+	Expect(TEXT("Sun noon elevation, 39.9N, December solstice"), Elevation, 26.66f, 0.25f);
+	CalculateSunPosition(39.9f, STANDARD_MERIDIAN, 12.0f * SECONDS_PER_HOUR, SecondsOfDate(79.0f, 0.0f), Elevation, Azimuth, PolarCondition);
+	Expect(TEXT("Sun noon elevation, 39.9N, March equinox"), Elevation, 50.1f, 1.0f);
+	
+	// Equator at equinox: the sun rises due east at 6:00.
+	CalculateSunPosition(0.0f, STANDARD_MERIDIAN, 6.0f * SECONDS_PER_HOUR, SecondsOfDate(79.0f, 0.0f), Elevation, Azimuth, PolarCondition);
+	Expect(TEXT("Sun elevation, equator, equinox 6:00"), Elevation, 0.0f, 0.1f);
+	ExpectAngle(TEXT("Sun azimuth, equator, equinox 6:00"), Azimuth, 90.0f, 1.5f);
+	
+	// London, 51.5N, June solstice: 16h38m between sunrise and sunset.
+	float HourAngle = 0.0f;
+	CalculateSunHourAngleAtElevation(51.5f, CalculateSolarDeclination(172.5f), -0.833f, HourAngle);
+	Expect(TEXT("Day length (hour), 51.5N, June solstice"), 2.0f * HourAngle / DEG_TO_HOUR, 16.633f, 0.17f);
+	
+	// Polar day and polar night at 80N.
+	CalculateSunPosition(80.0f, STANDARD_MERIDIAN, 0.0f, SecondsOfDate(172.0f, 0.0f), Elevation, Azimuth, PolarCondition);
+	Expect(TEXT("Polar condition, 80N, June solstice"), PolarCondition, 1.0f, 0.0f);
+	CalculateSunPosition(80.0f, STANDARD_MERIDIAN, 0.0f, SecondsOfDate(355.0f, 0.0f), Elevation, Azimuth, PolarCondition);
+	Expect(TEXT("Polar condition, 80N, December solstice"), PolarCondition, -1.0f, 0.0f);
+	
+	// Lunar phases of January 2000 (UT), the moon time base counts from 2000-01-01 0:00.
+	// The model keeps only the largest perturbation of the moon, a few degrees off is expected.
+	ExpectAngle(TEXT("Moon age angle, new moon 2000-01-06 18:14"), CalculateMoonAgeAngle(SecondsOfDate(5.0f, 18.23f)), 0.0f, 10.0f);
+	ExpectAngle(TEXT("Moon age angle, first quarter 2000-01-14 13:34"), CalculateMoonAgeAngle(SecondsOfDate(13.0f, 13.57f)), 90.0f, 10.0f);
+	ExpectAngle(TEXT("Moon age angle, full moon 2000-01-21 04:40"), CalculateMoonAgeAngle(SecondsOfDate(20.0f, 4.67f)), 180.0f, 10.0f);
+	ExpectAngle(TEXT("Moon age angle, last quarter 2000-01-28 07:57"), CalculateMoonAgeAngle(SecondsOfDate(27.0f, 7.95f)), 270.0f, 10.0f);
+	
+	float PhaseAngle, IlluminatedFraction, Illuminance;
+	CalculateMoonIllumination(180.0f, PhaseAngle, IlluminatedFraction, Illuminance);
+	Expect(TEXT("Full moon illuminated fraction"), IlluminatedFraction, 1.0f, 0.001f);
+	Expect(TEXT("Full moon zenith illuminance (lux)"), Illuminance, 0.26f, 0.05f);
+	
+	// Light direction points from the body to the ground, X north, Y east, Z up.
+	const FVector ZenithLight = ConvertPlanetLightDirection(90.0f, 0.0f);
+	Expect(TEXT("Light direction Z, body at zenith"), ZenithLight.Z, -1.0f, 0.0001f);
+	const FVector EastLight = ConvertPlanetLightDirection(0.0f, 90.0f);
+	Expect(TEXT("Light direction Y, body rising in the east"), EastLight.Y, -1.0f, 0.0001f);
+}
+
+/**
+ * The batched, per-day table, celestial frame and fast paths against the scalar reference.
+ */
+void FAetherMathVerification::VerifyConsistency()
+{
+	FAetherEphemerisSamples Samples;
+	Samples.InitRandom(4096);
+	const int32 Num = Samples.Num();
+	const TArray<float>& Latitude = Samples.Latitude;
+	const TArray<float>& Longitude = Samples.Longitude;
+	const TArray<float>& TimeStampOfEarthDay = Samples.TimeStampOfEarthDay;
+	const TArray<float>& TimeStampOfEarthYear = Samples.TimeStampOfEarthYear;
+	
+	TArray<float> BatchSunElevation, BatchSunAzimuth, FastSunElevation, FastSunAzimuth, BatchMoonElevation, BatchMoonAzimuth;
+	TArray<int32> BatchPolarCondition, FastPolarCondition;
+	BatchSunElevation.SetNumZeroed(Num);
+	BatchSunAzimuth.SetNumZeroed(Num);
+	FastSunElevation.SetNumZeroed(Num);
+	FastSunAzimuth.SetNumZeroed(Num);
+	BatchMoonElevation.SetNumZeroed(Num);
+	BatchMoonAzimuth.SetNumZeroed(Num);
+	BatchPolarCondition.SetNumZeroed(Num);
+	FastPolarCondition.SetNumZeroed(Num);
+	CalculateSunPositionBatch(Latitude.GetData(), Longitude.GetData(), TimeStampOfEarthDay.GetData(), TimeStampOfEarthYear.GetData(), BatchSunElevation.GetData(), BatchSunAzimuth.GetData(), BatchPolarCondition.GetData(), Num);
+	CalculateSunPositionBatch<FAetherFastMath>(Latitude.GetData(), Longitude.GetData(), TimeStampOfEarthDay.GetData(), TimeStampOfEarthYear.GetData(), FastSunElevation.GetData(), FastSunAzimuth.GetData(), FastPolarCondition.GetData(), Num);
+	CalculateMoonPositionBatch(Latitude.GetData(), Longitude.GetData(), TimeStampOfEarthDay.GetData(), TimeStampOfEarthYear.GetData(), BatchMoonElevation.GetData(), BatchMoonAzimuth.GetData(), Num);
+	
+	FAetherEphemerisTable Table;
+	Table.Build();
+	
+	auto AngularError = [](float ElevationA, float AzimuthA, float ElevationB, float AzimuthB)
+	{
+		const FVector A = ConvertPlanetDirection(ElevationA, AzimuthA);
+		const FVector B = ConvertPlanetDirection(ElevationB, AzimuthB);
+		return (float)FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(A, B), -1.0, 1.0)));
+	};
+	auto DirectionError = [](const FVector& A, const FVector3f& B)
+	{
+		return (float)FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(A, FVector(B)), -1.0, 1.0)));
+	};
+	
+	float SunBatchError = 0.0f;
+	float SunFastError = 0.0f;
+	float SunTableError = 0.0f;
+	float MoonBatchError = 0.0f;
+	float MoonTableError = 0.0f;
+	float SunFrameError = 0.0f;
+	float MoonFrameError = 0.0f;
+	FAetherCelestialFrame Frame;
+	for (int32 i = 0; i < Num; i++)
+	{
+		float SunElevation, SunAzimuth, MoonElevation, MoonAzimuth;
+		int32 PolarCondition;
+		CalculateSunPosition(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], SunElevation, SunAzimuth, PolarCondition);
+		CalculateMoonPosition(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], MoonElevation, MoonAzimuth);
+		
+		float TableSunElevation, TableSunAzimuth, TableMoonElevation, TableMoonAzimuth;
+		int32 TablePolarCondition;
+		Table.CalculatePlanetPosition(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i], TableSunElevation, TableSunAzimuth, TablePolarCondition, TableMoonElevation, TableMoonAzimuth);
+		
+		FVector3f FrameSunDirection, FrameMoonDirection;
+		int32 FramePolarCondition;
+		Frame.Build(Latitude[i], Longitude[i], TimeStampOfEarthDay[i], TimeStampOfEarthYear[i]);
+		Table.CalculatePlanetDirection(Frame, TimeStampOfEarthYear[i], FrameSunDirection, FramePolarCondition, FrameMoonDirection);
+		
+		// The polar condition pins the sun, a flip right at the threshold is not an error of the solver.
+		if (BatchPolarCondition[i] == PolarCondition)
+		{
+			SunBatchError = FMath::Max(SunBatchError, AngularError(SunElevation, SunAzimuth, BatchSunElevation[i], BatchSunAzimuth[i]));
+		}
+		if (FastPolarCondition[i] == PolarCondition)
+		{
+			SunFastError = FMath::Max(SunFastError, AngularError(SunElevation, SunAzimuth, FastSunElevation[i], FastSunAzimuth[i]));
+		}
+		if (TablePolarCondition == PolarCondition)
+		{
+			SunTableError = FMath::Max(SunTableError, AngularError(SunElevation, SunAzimuth, TableSunElevation, TableSunAzimuth));
+		}
+		MoonBatchError = FMath::Max(MoonBatchError, AngularError(MoonElevation, MoonAzimuth, BatchMoonElevation[i], BatchMoonAzimuth[i]));
+		MoonTableError = FMath::Max(MoonTableError, AngularError(MoonElevation, MoonAzimuth, TableMoonElevation, TableMoonAzimuth));
+		
+		if (FramePolarCondition == PolarCondition)
+		{
+			SunFrameError = FMath::Max(SunFrameError, DirectionError(ConvertPlanetDirection(SunElevation, SunAzimuth), FrameSunDirection));
+		}
+		MoonFrameError = FMath::Max(MoonFrameError, DirectionError(ConvertPlanetDirection(MoonElevation, MoonAzimuth), FrameMoonDirection));
+	}
+	
+	ExpectBelow(TEXT("Sun batch vs scalar, max error (deg)"), SunBatchError, 0.05f);
+	ExpectBelow(TEXT("Sun fast math vs scalar, max error (deg)"), SunFastError, 0.02f);
+	ExpectBelow(TEXT("Sun per-day table vs scalar, max error (deg)"), SunTableError, 0.05f);
+	ExpectBelow(TEXT("Moon batch vs scalar, max error (deg)"), MoonBatchError, 0.05f);
+	ExpectBelow(TEXT("Moon per-day table vs scalar, max error (deg)"), MoonTableError, 0.25f);
+	ExpectBelow(TEXT("Sun celestial frame vs scalar, max error (deg)"), SunFrameError, 0.05f);
+	ExpectBelow(TEXT("Moon celestial frame vs scalar, max error (deg)"), MoonFrameError, 0.25f);
+}
+
+/**
+ * Kepler solver residual over the whole eccentricity range, cold and warm started.
+ */
+void FAetherMathVerification::VerifyKepler()
+{
+	const int32 Num = 257;
+	TArray<FAetherOrbitalElements> Elements;
+	Elements.SetNum(Num);
+	FRandomStream Stream(0x4b65706c);
+	for (int32 i = 0; i < Num; i++)
+	{
+		Elements[i].Eccentricity = Stream.FRandRange(0.0f, 0.95f);
+		Elements[i].MeanAnomalyAtEpoch = Stream.FRandRange(0.0f, 360.0f);
+		Elements[i].OrbitalPeriod = Stream.FRandRange(1.0f, 400.0f);
+		Elements[i].Inclination = Stream.FRandRange(0.0f, 180.0f);
+	}
+	
+	FAetherKeplerSolver Solver;
+	Solver.Initialize(Elements);
+	
+	auto MaxResidual = [&Solver, &Elements](double Time)
+	{
+		float Residual = 0.0f;
+		for (int32 i = 0; i < Solver.Num(); i++)
+		{
+			const double MeanAnomaly = FMath::DegreesToRadians((double)Elements[i].MeanAnomalyAtEpoch) + UE_DOUBLE_TWO_PI / Elements[i].OrbitalPeriod * Time;
+			const double E = Solver.GetEccentricAnomaly(i);
+			const double Error = FMath::Fmod(E - Elements[i].Eccentricity * FMath::Sin(E) - MeanAnomaly, UE_DOUBLE_TWO_PI);
+			Residual = FMath::Max(Residual, (float)FMath::Min(FMath::Abs(Error), UE_DOUBLE_TWO_PI - FMath::Abs(Error)));
+		}
+		return Residual;
+	};
+	
+	const int32 ColdIterations = Solver.Solve(1234.5);
+	ExpectBelow(TEXT("Kepler cold start, max residual (rad)"), MaxResidual(1234.5), 1.0e-5f);
+	ExpectBelow(TEXT("Kepler cold start, Newton steps"), ColdIterations, FAetherKeplerSolver::MaxIterations - 1);
+	
+	// A tick of a fast day cycle, about two minutes of planet time.
+	const int32 WarmIterations = Solver.Solve(1234.5 + 0.0015);
+	ExpectBelow(TEXT("Kepler warm start, max residual (rad)"), MaxResidual(1234.5 + 0.0015), 1.0e-5f);
+	ExpectBelow(TEXT("Kepler warm start, Newton steps"), WarmIterations, 2.0f);
+	
+	// Circular orbit in the reference plane, a quarter period moves the body by 90 degrees.
+	FAetherOrbitalElements Circular;
+	Circular.OrbitalPeriod = 4.0f;
+	Solver.Initialize(MakeArrayView(&Circular, 1));
+	Solver.Solve(1.0);
+	Expect(TEXT("Circular orbit after a quarter period, Y"), Solver.GetPosition(0).Y, 1.0f, 1.0e-4f);
+}
+
+/**
+ * The clock after many small steps and one large skip, against the exact tick count.
+ */
+void FAetherMathVerification::VerifyClock()
+{
+	FAetherSimulationClock Clock;
+	Clock.Initialize(96);
+	
+	// One hour of 60 fps at a 30x time scale.
+	const int32 Steps = 3600 * 60;
+	for (int32 Step = 0; Step < Steps; Step++)
+	{
+		Clock.Advance(30.0 / 60.0, 1.0 / 60.0);
+	}
+	Expect(TEXT("Clock after 216000 small steps (s)"), (float)((double)Clock.GetTickOfYear() / FAetherSimulationClock::TicksPerSecond), 108000.0f, 1.0e-3f);
+	Expect(TEXT("Clock elapsed real time (s)"), (float)Clock.GetElapsedSeconds(), 3600.0f, 1.0e-3f);
+	
+	// Skip 1000 years and a quarter day.
+	Clock.Advance(1000.0 * 96 * SECONDS_PER_DAY_EARTH + 21600.0);
+	Expect(TEXT("Clock year after a 1000 years skip"), (float)Clock.GetYear(), 1000.0f, 0.0f);
+	Expect(TEXT("Clock second of day after the skip"), Clock.GetTimeStampOfEarthDay(), 108000.0f + 21600.0f - SECONDS_PER_DAY_EARTH, 1.0e-3f);
+	
+	Clock.Advance(-2.0 * SECONDS_PER_DAY_EARTH);
+	Expect(TEXT("Clock year after stepping back over new year"), (float)Clock.GetYear(), 999.0f, 0.0f);
+	Expect(TEXT("Clock day of year after stepping back"), (float)Clock.GetDayOfYear(), 95.0f, 0.0f);
+}
+
+namespace AetherWorldMathVerification
+{
+	/**
+	 * at.Math.Verify [exit]
+	 * Convenience wrapper of FAetherMathVerification in a running editor or game, CI runs the AetherMathTests target instead.
+	 * With "exit" the process quits with a non-zero code when any check fails.
+	 */
+	static void RunVerification(const TArray<FString>& Args)
+	{
+		FAetherMathVerification Verification;
+		Verification.VerifyAll();
+		
+		UE_LOG(LogAetherMath, Display, TEXT("Aether math verification:"));
+		for (const FAetherMathCheck& Check : Verification.GetChecks())
+		{
+			if (Check.IsPassed())
+			{
+				UE_LOG(LogAetherMath, Display, TEXT("  [PASS] %-48s %10.4f (expected %10.4f, tolerance %.4f)"), Check.Name, Check.Value, Check.Expected, Check.Tolerance);
+			}
+			else
+			{
+				UE_LOG(LogAetherMath, Error, TEXT("  [FAIL] %-48s %10.4f (expected %10.4f, tolerance %.4f)"), Check.Name, Check.Value, Check.Expected, Check.Tolerance);
+			}
+		}
+		const int32 NumFailed = Verification.GetNumFailed();
+		UE_LOG(LogAetherMath, Display, TEXT("Aether math verification: %d passed, %d failed."), Verification.GetChecks().Num() - NumFailed, NumFailed);
+		
+		if (Args.Contains(TEXT("exit")))
+		{
+			FPlatformMisc::RequestExitWithStatus(false, NumFailed > 0 ? 1 : 0);
+		}
+	}
+	
+	static FAutoConsoleCommand CmdMathVerification(
+		TEXT("at.Math.Verify"),
+		TEXT("Check the celestial math against almanac values and cross-check the batched, per-day table, celestial frame and fast paths, the Kepler solver and the simulation clock. Usage: at.Math.Verify [exit]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunVerification));
+}
\ No newline at end of file
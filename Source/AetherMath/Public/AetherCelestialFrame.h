@@ -0,0 +1,118 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Observer dependent part of the celestial math, built once per tick.
+ * Holds local sidereal time, the equatorial to horizon rotation and the obliquity terms,
+ * any body given by its equatorial or ecliptic direction is then placed in the sky by a single matrix-vector product.
+ * Horizon frame: X north, Y east, Z up, same as ConvertPlanetDirection.
+ */
+struct AETHERMATH_API FAetherCelestialFrame
+{
+public:
+	FAetherCelestialFrame();
+	
+	/**
+	 * @param Latitude Degree, north positive.
+	 * @param Longitude Degree, east positive.
+	 * @param TimeStampOfEarthDay Second of the local day, drives the solar hour angle.
+	 * @param TimeStampOfEarthYear Second since the epoch of the year, drives the sidereal time.
+	 * @param bFastMath Use the polynomial approximation of FAetherFastMath.
+	 */
+	void Build(float Latitude, float Longitude, float TimeStampOfEarthDay, float TimeStampOfEarthYear, bool bFastMath = false);
+	
+	/**
+	 * Frame of an arbitrary planet, the caller drives the rotation. GetSunDirection is meaningless on such a frame.
+	 * @param LocalSiderealTime Radian, angle from the reference direction of the orbital plane to the local meridian.
+	 * @param Obliquity Degree, axial tilt of the planet against its orbital plane.
+	 */
+	void BuildFromSiderealTime(float Latitude, float LocalSiderealTime, float Obliquity, bool bFastMath = false);
+	
+	/**
+	 * Unit vector toward right ascension / declination, X at the vernal equinox, Z at the celestial north pole. Radian.
+	 */
+	static FVector3f MakeEquatorialDirection(float RightAscension, float Declination);
+	
+	/**
+	 * Unit vector toward ecliptic longitude / latitude, X at the vernal equinox, Z at the ecliptic north pole. Radian.
+	 */
+	static FVector3f MakeEclipticDirection(float EclipticLongitude, float EclipticLatitude);
+	
+	FORCEINLINE FVector3f TransformEquatorial(const FVector3f& EquatorialDirection) const
+	{
+		return FVector3f(
+			FVector3f::DotProduct(EquatorialToHorizon[0], EquatorialDirection),
+			FVector3f::DotProduct(EquatorialToHorizon[1], EquatorialDirection),
+			FVector3f::DotProduct(EquatorialToHorizon[2], EquatorialDirection));
+	}
+	
+	FORCEINLINE FVector3f TransformEcliptic(const FVector3f& EclipticDirection) const
+	{
+		return FVector3f(
+			FVector3f::DotProduct(EclipticToHorizon[0], EclipticDirection),
+			FVector3f::DotProduct(EclipticToHorizon[1], EclipticDirection),
+			FVector3f::DotProduct(EclipticToHorizon[2], EclipticDirection));
+	}
+	
+	/**
+	 * For catalogs, e.g. a star field.
+	 */
+	void TransformEquatorial(const FVector3f* RESTRICT EquatorialDirection, FVector3f* RESTRICT HorizonDirection, int32 Num) const;
+	
+	/**
+	 * Body given by its hour angle instead of right ascension.
+	 */
+	FORCEINLINE FVector3f TransformHourAngle(float SinHourAngle, float CosHourAngle, float SinDeclination, float CosDeclination) const
+	{
+		const float X = CosDeclination * CosHourAngle;
+		return FVector3f(
+			CosLatitude * SinDeclination - SinLatitude * X,
+			-CosDeclination * SinHourAngle,
+			SinLatitude * SinDeclination + CosLatitude * X);
+	}
+	
+	/**
+	 * The sun runs on local solar time, not on the sidereal time, its hour angle is solved in Build.
+	 */
+	FORCEINLINE FVector3f GetSunDirection(float SinDeclination, float CosDeclination) const
+	{
+		return TransformHourAngle(SinSunHourAngle, CosSunHourAngle, SinDeclination, CosDeclination);
+	}
+	
+	FORCEINLINE float GetSinLatitude() const { return SinLatitude; }
+	FORCEINLINE float GetCosLatitude() const { return CosLatitude; }
+	
+	/**
+	 * Radian.
+	 */
+	FORCEINLINE float GetLocalSiderealTime() const { return LocalSiderealTime; }
+	
+	FORCEINLINE float GetSinObliquity() const { return SinObliquity; }
+	FORCEINLINE float GetCosObliquity() const { return CosObliquity; }
+	
+private:
+	void BuildRotation(float SinSiderealTime, float CosSiderealTime);
+	
+	float SinLatitude;
+	float CosLatitude;
+	
+	float LocalSiderealTime;
+	
+	float SinSunHourAngle;
+	float CosSunHourAngle;
+	
+	float SinObliquity;
+	float CosObliquity;
+	
+	/**
+	 * Rows of the rotation matrices, output component = dot(row, input).
+	 */
+	FVector3f EquatorialToHorizon[3];
+	FVector3f EclipticToHorizon[3];
+};
\ No newline at end of file
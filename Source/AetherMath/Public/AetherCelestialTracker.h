@@ -0,0 +1,68 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Tracks the sun and moon light direction between two full solves.
+ * Bodies are advanced by rotating around the local celestial pole at their known hour angle rate,
+ * observer movement is folded in as a longitude (hour angle) and latitude (pole elevation) rotation.
+ * A full solve is requested at an interval that adapts to the drift measured on each resync.
+ */
+struct AETHERMATH_API FAetherCelestialTracker
+{
+public:
+	FAetherCelestialTracker();
+	
+	void Invalidate();
+	
+	/**
+	 * Advance tracked directions to the given time and observer coordinate.
+	 * @return false if a full solve is required, the caller should solve then Resync.
+	 */
+	bool Advance(
+		float DeltaTime,
+		float Latitude,
+		float Longitude,
+		double ProgressOfYear,
+		int32 DaysPerYear,
+		float MaxTrackedAngle,
+		FVector& OutSunLightDirection,
+		FVector& OutMoonLightDirection);
+	
+	void Resync(
+		float Latitude,
+		float Longitude,
+		double ProgressOfYear,
+		int32 PolarCondition,
+		const FVector& SunLightDirection,
+		const FVector& MoonLightDirection,
+		float ResolveInterval,
+		float ErrorThreshold);
+	
+	/**
+	 * Degree. Drift between tracked and solved direction measured on last resync.
+	 */
+	float GetLastDrift() const { return LastDrift; }
+	
+private:
+	bool bValid;
+	bool bHasPrediction;
+	
+	float LastLatitude;
+	float LastLongitude;
+	double LastProgressOfYear;
+	int32 LastPolarCondition;
+	
+	FVector SunLightDirection;
+	FVector MoonLightDirection;
+	
+	float TimeSinceSolve;
+	float TrackedAngle;
+	float CurrentInterval;
+	float LastDrift;
+};
\ No newline at end of file
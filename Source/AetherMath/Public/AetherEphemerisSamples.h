@@ -0,0 +1,38 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Input points of the ephemeris routines by field, shared by the benchmarks, the verification and the low-level tests.
+ */
+struct AETHERMATH_API FAetherEphemerisSamples
+{
+public:
+	// Seed of the random points the benchmark and the verification use.
+	static constexpr int32 DefaultSeed = 0x41657468;
+	
+	TArray<float> Latitude;
+	TArray<float> Longitude;
+	TArray<float> TimeStampOfEarthDay;
+	TArray<float> TimeStampOfEarthYear;
+	
+	/**
+	 * Uniform random points, latitude within +-89 degree. The same seed gives the same points.
+	 */
+	void InitRandom(int32 Num, int32 Seed = DefaultSeed);
+	
+	/**
+	 * Regular sweep of latitude, longitude, time of day and time of year, at the center of each step.
+	 */
+	void InitSweep(int32 LatitudeSteps, int32 LongitudeSteps, int32 DaySteps, int32 YearSteps);
+	
+	FORCEINLINE int32 Num() const { return Latitude.Num(); }
+	
+private:
+	void SetNum(int32 Num);
+};
\ No newline at end of file
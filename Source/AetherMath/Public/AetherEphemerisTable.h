@@ -0,0 +1,76 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAetherCelestialFrame;
+
+/**
+ * Slowly varying solar/lunar terms sampled at 0:00 of a day of year.
+ */
+struct FAetherEphemerisDay
+{
+	float SunSinDeclination;
+	float SunCosDeclination;
+	
+	/**
+	 * Radian. Unwrapped along the table so that two adjacent days interpolate without a seam.
+	 */
+	float MoonRightAscension;
+	float MoonSinDeclination;
+	float MoonCosDeclination;
+	
+	/**
+	 * Unit vector of the moon right ascension / declination, see FAetherCelestialFrame::MakeEquatorialDirection.
+	 */
+	FVector3f MoonEquatorialDirection;
+};
+
+/**
+ * Per-day-of-year ephemeris, built once by the subsystem.
+ * The declination of the sun and the equatorial coordinate of the moon only change slowly across a day,
+ * they are looked up and linearly interpolated, only the hour angle dependent part is evaluated per tick.
+ */
+struct AETHERMATH_API FAetherEphemerisTable
+{
+public:
+	void Build();
+	
+	bool IsBuilt() const { return Days.Num() > 0; }
+	
+	FAetherEphemerisDay Sample(float TimeStampOfEarthYear) const;
+	
+	/**
+	 * Same output as CalculateSunPosition and CalculateMoonPosition, both bodies are solved in one SIMD pass.
+	 * @param bFastMath Use the polynomial approximation of FAetherFastMath instead of the engine trigonometry.
+	 */
+	void CalculatePlanetPosition(
+		float Latitude,
+		float Longitude,
+		float TimeStampOfEarthDay,
+		float TimeStampOfEarthYear,
+		float& SunElevation,
+		float& SunAzimuth,
+		int32& PolarCondition,
+		float& MoonElevation,
+		float& MoonAzimuth,
+		bool bFastMath = false) const;
+	
+	/**
+	 * Direction from the observer to the sun and the moon in the horizon frame of the celestial frame.
+	 * Only the transforms of the frame are evaluated, no trigonometry per body.
+	 */
+	void CalculatePlanetDirection(
+		const FAetherCelestialFrame& Frame,
+		float TimeStampOfEarthYear,
+		FVector3f& SunDirection,
+		int32& PolarCondition,
+		FVector3f& MoonDirection) const;
+	
+private:
+	TArray<FAetherEphemerisDay> Days;
+};
\ No newline at end of file
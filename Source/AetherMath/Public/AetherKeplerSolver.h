@@ -0,0 +1,88 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Keplerian elements of a body around the observed planet, angles in degree, period in planet day.
+ * Reference plane is the orbital plane of the planet, a sun is described by the orbit of the planet seen from the planet,
+ * i.e. the planet elements with the argument of periapsis turned by 180 degrees.
+ */
+struct FAetherOrbitalElements
+{
+	float SemiMajorAxis = 1.0f;
+	float Eccentricity = 0.0f;
+	float Inclination = 0.0f;
+	float LongitudeOfAscendingNode = 0.0f;
+	float ArgumentOfPeriapsis = 0.0f;
+	float MeanAnomalyAtEpoch = 0.0f;
+	float OrbitalPeriod = 1.0f;
+};
+
+/**
+ * Solves Kepler's equation M = E - e·sin(E) for every body in one batched pass, four bodies per SIMD register.
+ * The eccentric anomaly of the previous solve warm starts Newton's iteration, within a tick it converges in one or two steps.
+ */
+class AETHERMATH_API FAetherKeplerSolver
+{
+public:
+	void Initialize(TConstArrayView<FAetherOrbitalElements> Elements);
+	
+	/**
+	 * Forget the previous solution, the next Solve starts cold.
+	 */
+	void Invalidate() { bWarmStart = false; }
+	
+	/**
+	 * @param Time Planet day since the epoch of the elements, double so long sessions keep the mean anomaly precise.
+	 * @return Newton steps taken.
+	 */
+	int32 Solve(double Time, bool bFastMath = false);
+	
+	FORCEINLINE int32 Num() const { return NumBodies; }
+	
+	/**
+	 * Position in the reference frame, X toward the ascending node reference direction, Z toward the pole of the reference plane.
+	 */
+	FORCEINLINE FVector3f GetPosition(int32 Index) const { return FVector3f(PositionX[Index], PositionY[Index], PositionZ[Index]); }
+	
+	FORCEINLINE float GetEccentricAnomaly(int32 Index) const { return EccentricAnomaly[Index]; }
+	
+	/**
+	 * Bound of the Newton step |ΔE| in radian, the iteration stops once every body is below it.
+	 * The fast path bottoms out at the error of its polynomial sine, about 0.01 degree.
+	 */
+	static constexpr float Tolerance = 2.0e-6f;
+	static constexpr float FastMathTolerance = 2.0e-4f;
+	static constexpr int32 MaxIterations = 12;
+	
+private:
+	template<typename MathPolicy>
+	int32 SolveInternal(float StepTolerance);
+	
+	int32 NumBodies = 0;
+	bool bWarmStart = false;
+	
+	// Per body, padded to a multiple of 4.
+	TArray<double> MeanAnomalyAtEpoch;
+	TArray<double> MeanMotion;
+	TArray<float> Eccentricity;
+	TArray<float> SemiMajorAxis;
+	TArray<float> SemiMinorAxis;
+	
+	// Perifocal basis, P toward the periapsis, Q 90 degrees ahead in the orbital plane.
+	TArray<float> PX, PY, PZ;
+	TArray<float> QX, QY, QZ;
+	
+	TArray<float> MeanAnomaly;
+	TArray<float> EccentricAnomaly;
+	
+	// E - M = e·sin(E) of the last solve, it changes slowly and does not wrap with the mean anomaly.
+	TArray<float> AnomalyOffset;
+	
+	TArray<float> PositionX, PositionY, PositionZ;
+};
\ No newline at end of file
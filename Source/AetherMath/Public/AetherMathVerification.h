@@ -0,0 +1,45 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAetherMathCheck
+{
+	const TCHAR* Name;
+	float Value;
+	float Expected;
+	float Error;
+	float Tolerance;
+	
+	FORCEINLINE bool IsPassed() const { return Error <= Tolerance; }
+};
+
+/**
+ * The celestial math against almanac values, the batched, per-day table, celestial frame and fast paths against the scalar reference,
+ * the Kepler solver and the simulation clock. Nothing is logged, the AetherMathTests target and at.Math.Verify report the checks.
+ */
+struct AETHERMATH_API FAetherMathVerification
+{
+public:
+	void VerifyAlmanac();
+	void VerifyConsistency();
+	void VerifyKepler();
+	void VerifyClock();
+	
+	void VerifyAll();
+	
+	int32 GetNumFailed() const;
+	
+	FORCEINLINE const TArray<FAetherMathCheck>& GetChecks() const { return Checks; }
+	
+private:
+	void Expect(const TCHAR* Name, float Value, float Expected, float Tolerance);
+	void ExpectAngle(const TCHAR* Name, float Value, float Expected, float Tolerance);
+	void ExpectBelow(const TCHAR* Name, float Value, float Limit);
+	
+	TArray<FAetherMathCheck> Checks;
+};
\ No newline at end of file
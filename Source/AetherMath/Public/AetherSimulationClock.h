@@ -0,0 +1,76 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Single source of truth of the simulated time: integer microseconds into the simulated year plus a year counter.
+ * Float views are derived on demand and never fed back, large time scales and long sessions do not accumulate error.
+ * A simulated day lasts 86400 simulated seconds, as TimeStampOfEarthDay.
+ */
+struct AETHERMATH_API FAetherSimulationClock
+{
+public:
+	static constexpr int64 TicksPerSecond = 1000000;
+	static constexpr int64 TicksPerDay = 86400 * TicksPerSecond;
+	
+	FAetherSimulationClock();
+	
+	/**
+	 * Restart at year 0.
+	 */
+	void Initialize(int32 InDaysPerYear, double ProgressOfYear = 0.0);
+	
+	/**
+	 * @param SimulatedSeconds Any size and sign, whole years are carried into the year counter.
+	 * @param RealSeconds Unscaled frame time, only accumulated for GetElapsedSeconds.
+	 * @return Signed count of year boundaries crossed.
+	 */
+	int64 Advance(double SimulatedSeconds, double RealSeconds = 0.0);
+	
+	void SetTime(int64 InYear, int64 InTickOfYear);
+	
+	FORCEINLINE int32 GetDaysPerYear() const { return DaysPerYear; }
+	FORCEINLINE int64 GetYear() const { return Year; }
+	FORCEINLINE int64 GetTickOfYear() const { return TickOfYear; }
+	FORCEINLINE int64 GetTicksPerYear() const { return TicksPerYear; }
+	
+	FORCEINLINE int32 GetDayOfYear() const { return (int32)(TickOfYear / TicksPerDay); }
+	
+	FORCEINLINE double GetProgressOfYear() const { return (double)TickOfYear / TicksPerYear; }
+	FORCEINLINE double GetProgressOfDay() const { return (double)(TickOfYear % TicksPerDay) / TicksPerDay; }
+	
+	/**
+	 * Second of the simulated day, exact to the microsecond whatever the date.
+	 */
+	FORCEINLINE float GetTimeStampOfEarthDay() const { return (float)((double)(TickOfYear % TicksPerDay) / TicksPerSecond); }
+	
+	/**
+	 * The simulated year mapped onto the 365 days of the Earth ephemeris.
+	 */
+	float GetTimeStampOfEarthYear() const;
+	
+	/**
+	 * Simulated days since year 0, day 0.
+	 */
+	FORCEINLINE double GetTotalDays() const { return (double)Year * DaysPerYear + (double)TickOfYear / TicksPerDay; }
+	
+	FORCEINLINE double GetElapsedSeconds() const { return (double)ElapsedTicks / TicksPerSecond; }
+	
+private:
+	int64 Year;
+	int64 TickOfYear;
+	int64 TicksPerYear;
+	int32 DaysPerYear;
+	
+	// Unscaled time since Initialize.
+	int64 ElapsedTicks;
+	
+	// Fraction of a microsecond carried between two Advance calls, so tiny steps are never rounded away.
+	double SubTickRemainder;
+	double ElapsedSubTickRemainder;
+};
\ No newline at end of file
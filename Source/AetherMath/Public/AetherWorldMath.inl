@@ -0,0 +1,775 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#define SECONDS_PER_HOUR 3600.0f
+#define SECONDS_PER_DAY_EARTH 86400.0f
+#define SECONDS_PER_YEAR_EARTH 31536000.0f
+#define DAYS_PER_YEAR_EARTH 365
+
+#define OBLIQUITY 23.45f				// 黄赤交角（度）
+#define STANDARD_MERIDIAN 120.0f		// 标准时区经度（东八区）
+#define DEG_TO_HOUR 15.0f				// 度到小时转换系数（1小时=15度）
+
+#define J2000_JD 2451545
+#define DAYS_PER_CENTURY 36525
+
+//#define DEG_TO_RAD (PI / 180.0f)
+//#define RAD_TO_DEG (180.0f / PI)
+
+/**
+ * 精确路径：直接转发FMath与引擎向量库
+ */
+struct FAetherPreciseMath
+{
+	static FORCEINLINE void SinCos(float* S, float* C, const float X) { FMath::SinCos(S, C, X); }
+	static FORCEINLINE float Sin(const float X) { return FMath::Sin(X); }
+	static FORCEINLINE float Cos(const float X) { return FMath::Cos(X); }
+	static FORCEINLINE float Asin(const float X) { return FMath::Asin(X); }
+	static FORCEINLINE float Acos(const float X) { return FMath::Acos(X); }
+	static FORCEINLINE float Atan2(const float Y, const float X) { return FMath::Atan2(Y, X); }
+	static FORCEINLINE float Fmod(const float X, const float Y) { return FMath::Fmod(X, Y); }
+	
+	static FORCEINLINE void VectorSinCos(VectorRegister4Float* RESTRICT S, VectorRegister4Float* RESTRICT C, const VectorRegister4Float* RESTRICT X) { ::VectorSinCos(S, C, X); }
+	static FORCEINLINE VectorRegister4Float VectorSin(const VectorRegister4Float& X) { return ::VectorSin(X); }
+	static FORCEINLINE VectorRegister4Float VectorASin(const VectorRegister4Float& X) { return ::VectorASin(X); }
+	static FORCEINLINE VectorRegister4Float VectorATan2(const VectorRegister4Float& Y, const VectorRegister4Float& X) { return ::VectorATan2(Y, X); }
+};
+
+/**
+ * 快速路径：先约化角度，再用低阶极小化多项式逼近，满足画面所需的约0.01度精度
+ * sin：[0, π/2] 5阶，误差 6.8e-5
+ * cos：[0, π/2] 6阶，误差 6.7e-6
+ * atan：[0, 1] 7阶，误差 8.1e-5
+ * asin：Abramowitz & Stegun 4.4.45，误差 6.8e-5
+ * 误差与吞吐可用 at.Math.Validate 对照精确路径测量
+ */
+struct FAetherFastMath
+{
+	static constexpr float S1 = 0.999696786f;
+	static constexpr float S3 = -0.165673097f;
+	static constexpr float S5 = 0.00751438254f;
+	
+	static constexpr float C0 = 0.999993321f;
+	static constexpr float C2 = -0.499912524f;
+	static constexpr float C4 = 0.0414878169f;
+	static constexpr float C6 = -0.00127122549f;
+	
+	static constexpr float T1 = 0.99921382f;
+	static constexpr float T3 = -0.321174976f;
+	static constexpr float T5 = 0.146264422f;
+	static constexpr float T7 = -0.0389864725f;
+	
+	static constexpr float A0 = 1.5707288f;
+	static constexpr float A1 = -0.2121144f;
+	static constexpr float A2 = 0.0742610f;
+	static constexpr float A3 = -0.0187293f;
+	
+	static FORCEINLINE void SinCos(float* S, float* C, const float X)
+	{
+		// 约化到[-π, π]，再折叠到[-π/2, π/2]
+		float Y = X - UE_TWO_PI * FMath::FloorToFloat(X * UE_INV_TWO_PI + 0.5f);
+		float Sign = 1.0f;
+		if (Y > UE_HALF_PI)
+		{
+			Y = UE_PI - Y;
+			Sign = -1.0f;
+		}
+		else if (Y < -UE_HALF_PI)
+		{
+			Y = -UE_PI - Y;
+			Sign = -1.0f;
+		}
+		const float Y2 = Y * Y;
+		*S = Y * (S1 + Y2 * (S3 + Y2 * S5));
+		*C = Sign * (C0 + Y2 * (C2 + Y2 * (C4 + Y2 * C6)));
+	}
+	
+	static FORCEINLINE float Sin(const float X) { float S, C; SinCos(&S, &C, X); return S; }
+	static FORCEINLINE float Cos(const float X) { float S, C; SinCos(&S, &C, X); return C; }
+	
+	static FORCEINLINE float Asin(const float X)
+	{
+		const float AX = FMath::Abs(X);
+		const float Result = UE_HALF_PI - FMath::Sqrt(FMath::Max(1.0f - AX, 0.0f)) * (A0 + AX * (A1 + AX * (A2 + AX * A3)));
+		return X < 0.0f ? -Result : Result;
+	}
+	
+	static FORCEINLINE float Acos(const float X) { return UE_HALF_PI - Asin(X); }
+	
+	static FORCEINLINE float Atan2(const float Y, const float X)
+	{
+		const float AX = FMath::Abs(X);
+		const float AY = FMath::Abs(Y);
+		const float MaxValue = FMath::Max(AX, AY);
+		if (MaxValue <= 0.0f)
+		{
+			return 0.0f;
+		}
+		const float T = FMath::Min(AX, AY) / MaxValue;
+		const float T2 = T * T;
+		float Result = T * (T1 + T2 * (T3 + T2 * (T5 + T2 * T7)));
+		Result = AY > AX ? UE_HALF_PI - Result : Result;
+		Result = X < 0.0f ? UE_PI - Result : Result;
+		return Y < 0.0f ? -Result : Result;
+	}
+	
+	static FORCEINLINE float Fmod(const float X, const float Y) { return X - Y * FMath::TruncToFloat(X / Y); }
+	
+	static FORCEINLINE void VectorSinCos(VectorRegister4Float* RESTRICT S, VectorRegister4Float* RESTRICT C, const VectorRegister4Float* RESTRICT X)
+	{
+		const VectorRegister4Float HalfPi = VectorSetFloat1(UE_HALF_PI);
+		const VectorRegister4Float Quotient = VectorFloor(VectorMultiplyAdd(*X, VectorSetFloat1(UE_INV_TWO_PI), GlobalVectorConstants::FloatOneHalf));
+		const VectorRegister4Float Y = VectorNegateMultiplyAdd(Quotient, VectorSetFloat1(UE_TWO_PI), *X);
+		
+		// |Y| > π/2 时折叠：Y' = sign(Y)·π - Y，cos取反
+		const VectorRegister4Float FoldMask = VectorCompareGT(VectorAbs(Y), HalfPi);
+		const VectorRegister4Float SignedPi = VectorSelect(VectorCompareLT(Y, GlobalVectorConstants::FloatZero), VectorSetFloat1(-UE_PI), VectorSetFloat1(UE_PI));
+		const VectorRegister4Float Folded = VectorSelect(FoldMask, VectorSubtract(SignedPi, Y), Y);
+		const VectorRegister4Float Y2 = VectorMultiply(Folded, Folded);
+		
+		*S = VectorMultiply(Folded, VectorMultiplyAdd(Y2, VectorMultiplyAdd(Y2, VectorSetFloat1(S5), VectorSetFloat1(S3)), VectorSetFloat1(S1)));
+		const VectorRegister4Float Cosine = VectorMultiplyAdd(Y2, VectorMultiplyAdd(Y2, VectorMultiplyAdd(Y2, VectorSetFloat1(C6), VectorSetFloat1(C4)), VectorSetFloat1(C2)), VectorSetFloat1(C0));
+		*C = VectorSelect(FoldMask, VectorNegate(Cosine), Cosine);
+	}
+	
+	static FORCEINLINE VectorRegister4Float VectorSin(const VectorRegister4Float& X)
+	{
+		VectorRegister4Float S, C;
+		VectorSinCos(&S, &C, &X);
+		return S;
+	}
+	
+	static FORCEINLINE VectorRegister4Float VectorASin(const VectorRegister4Float& X)
+	{
+		const VectorRegister4Float AX = VectorAbs(X);
+		const VectorRegister4Float Poly = VectorMultiplyAdd(AX, VectorMultiplyAdd(AX, VectorMultiplyAdd(AX, VectorSetFloat1(A3), VectorSetFloat1(A2)), VectorSetFloat1(A1)), VectorSetFloat1(A0));
+		const VectorRegister4Float Root = VectorSqrt(VectorMax(VectorSubtract(GlobalVectorConstants::FloatOne, AX), GlobalVectorConstants::FloatZero));
+		const VectorRegister4Float Result = VectorNegateMultiplyAdd(Root, Poly, VectorSetFloat1(UE_HALF_PI));
+		return VectorSelect(VectorCompareLT(X, GlobalVectorConstants::FloatZero), VectorNegate(Result), Result);
+	}
+	
+	static FORCEINLINE VectorRegister4Float VectorATan2(const VectorRegister4Float& Y, const VectorRegister4Float& X)
+	{
+		const VectorRegister4Float AX = VectorAbs(X);
+		const VectorRegister4Float AY = VectorAbs(Y);
+		const VectorRegister4Float MaxValue = VectorMax(VectorMax(AX, AY), GlobalVectorConstants::SmallNumber);
+		const VectorRegister4Float T = VectorDivide(VectorMin(AX, AY), MaxValue);
+		const VectorRegister4Float T2 = VectorMultiply(T, T);
+		VectorRegister4Float Result = VectorMultiply(T, VectorMultiplyAdd(T2, VectorMultiplyAdd(T2, VectorMultiplyAdd(T2, VectorSetFloat1(T7), VectorSetFloat1(T5)), VectorSetFloat1(T3)), VectorSetFloat1(T1)));
+		Result = VectorSelect(VectorCompareGT(AY, AX), VectorSubtract(VectorSetFloat1(UE_HALF_PI), Result), Result);
+		Result = VectorSelect(VectorCompareLT(X, GlobalVectorConstants::FloatZero), VectorSubtract(VectorSetFloat1(UE_PI), Result), Result);
+		return VectorSelect(VectorCompareLT(Y, GlobalVectorConstants::FloatZero), VectorNegate(Result), Result);
+	}
+};
+
+/**
+ * 计算太阳赤纬角（δ）（使用标准近似公式）
+ * @param DateOfYear 年序日（0~365）
+ * @return 太阳赤纬角（弧度）
+ */
+template<typename MathPolicy = FAetherPreciseMath>
+inline float CalculateSolarDeclination(const float& DateOfYear)
+{
+	return FMath::DegreesToRadians(OBLIQUITY * MathPolicy::Sin(2 * PI * (284.0f + DateOfYear) / DAYS_PER_YEAR_EARTH));
+}
+
+/**
+ * 计算指定地理位置和时间的太阳位置（高度角、方位角）及极地条件
+ * @param Latitude 纬度（度），北纬为正
+ * @param Longitude 经度（度），东经为正
+ * @param TimeStampOfEarthDay 当日累计秒数（0~86400）
+ * @param TimeStampOfEarthYear 当年累计秒数（0~31536000）
+ * @param SunElevation [输出] 太阳高度角（度），地平线以上为正值
+ * @param SunAzimuth [输出] 太阳方位角（度），从正北顺时针测量
+ * @param PolarCondition [输出] 极地条件标志：0=正常，1=极昼，-1=极夜
+ */
+template<typename MathPolicy = FAetherPreciseMath>
+inline void CalculateSunPosition(
+    const float& Latitude,
+    const float& Longitude,
+    const float& TimeStampOfEarthDay,
+    const float& TimeStampOfEarthYear,
+    float& SunElevation,
+    float& SunAzimuth,
+    int32& PolarCondition)
+{
+    // ===== 1. 输入预处理 =====
+    // 计算年序日（Day of Year, 1-365）
+    float DateOfYear = MathPolicy::Fmod(TimeStampOfEarthYear / SECONDS_PER_DAY_EARTH, DAYS_PER_YEAR_EARTH);
+    
+    // 将秒转换为小时（地方时）
+    float LocalHour = TimeStampOfEarthDay / SECONDS_PER_HOUR;
+    
+    // ===== 2. 天文参数计算 =====
+    // 计算太阳赤纬角（δ），单位：弧度（使用标准近似公式）
+    float SolarDeclination = CalculateSolarDeclination<MathPolicy>(DateOfYear);
+    
+    // 计算时角（H），单位：弧度
+    // a. 经度转换为时区修正（15度=1小时）
+    float TimeZoneCorrection = (Longitude - STANDARD_MERIDIAN) / DEG_TO_HOUR;
+    // b. 计算真太阳时
+    float LocalSolarTime = LocalHour + TimeZoneCorrection;
+    // c. 计算时角（度）并转换为弧度
+    float HourAngleDeg = DEG_TO_HOUR * (LocalSolarTime - 12.0f);
+    float HourAngleRad = FMath::DegreesToRadians(HourAngleDeg);
+    
+    // 纬度转换为弧度
+    float LatRad = FMath::DegreesToRadians(Latitude);
+    
+    // ===== 3. 太阳高度角计算 =====
+    // 使用标准球面三角公式：sin(α) = sin(φ)sin(δ) + cos(φ)cos(δ)cos(H)
+    float SinElevation = MathPolicy::Sin(LatRad) * MathPolicy::Sin(SolarDeclination) 
+                       + MathPolicy::Cos(LatRad) * MathPolicy::Cos(SolarDeclination) * MathPolicy::Cos(HourAngleRad);
+    
+    // 处理浮点精度溢出，确保值在[-1, 1]范围内
+    SinElevation = FMath::Clamp(SinElevation, -1.0f, 1.0f);
+    
+    // 计算高度角弧度值（后续计算会复用）
+    float ElevationRad = MathPolicy::Asin(SinElevation);
+    SunElevation = FMath::RadiansToDegrees(ElevationRad);
+    
+    // ===== 4. 太阳方位角计算 =====
+    // 公式：cos(Az) = [sin(δ) - sin(α)sin(φ)] / [cos(α)cos(φ)]
+	// 计算方位角的正弦和余弦分量
+	float sinAzimuth = -MathPolicy::Cos(SolarDeclination) * MathPolicy::Sin(HourAngleRad);
+	float cosAzimuth = MathPolicy::Sin(SolarDeclination) * MathPolicy::Cos(LatRad) 
+					 - MathPolicy::Cos(SolarDeclination) * MathPolicy::Sin(LatRad) * MathPolicy::Cos(HourAngleRad);
+	
+	// 使用atan2计算方位角（弧度）
+	float azimuthRad = MathPolicy::Atan2(sinAzimuth, cosAzimuth);
+	
+	// 转换为度数并确保在0-360度范围内
+	SunAzimuth = FMath::RadiansToDegrees(azimuthRad);
+	SunAzimuth = MathPolicy::Fmod(SunAzimuth + 360.0f, 360.0f);
+	
+    // ===== 5. 极昼/极夜检测 =====
+    // 计算临界角余弦值（用于判断太阳是否可能升起）
+    float CriticalAngleCos = -MathPolicy::Sin(LatRad) * MathPolicy::Sin(SolarDeclination) / (MathPolicy::Cos(LatRad) * MathPolicy::Cos(SolarDeclination));
+    
+    // 判断逻辑
+    PolarCondition = 0; // 默认正常
+    if (CriticalAngleCos > 1.0f)
+    {
+        PolarCondition = -1; // 极夜（全天无日出）
+        SunElevation = -90.0f; // 太阳位于地平线以下
+    }
+	else if (CriticalAngleCos < -1.0f)
+	{
+        PolarCondition = 1;  // 极昼（全天有日照）
+        SunElevation = 90.0f; // 太阳位于头顶
+    }
+}
+
+/**
+ * 计算太阳到达指定高度角时的时角（日出日落、晨昏蒙影）
+ * @param Latitude 纬度（度），北纬为正
+ * @param SolarDeclination 太阳赤纬角（弧度）
+ * @param Elevation 目标高度角（度）：日出日落-0.833，民用-6，航海-12，天文-18
+ * @param HourAngle [输出] 时角（度，0~180），上升时刻为-HourAngle，下降时刻为+HourAngle
+ * @return 0=有解，1=全天高于目标高度角，-1=全天低于目标高度角
+ */
+inline int32 CalculateSunHourAngleAtElevation(
+	const float& Latitude,
+	const float& SolarDeclination,
+	const float& Elevation,
+	float& HourAngle)
+{
+	// 由 sin(α) = sin(φ)sin(δ) + cos(φ)cos(δ)cos(H) 反解 H
+	float LatRad = FMath::DegreesToRadians(Latitude);
+	float CosHourAngle = (FMath::Sin(FMath::DegreesToRadians(Elevation)) - FMath::Sin(LatRad) * FMath::Sin(SolarDeclination))
+					   / (FMath::Cos(LatRad) * FMath::Cos(SolarDeclination));
+	if (CosHourAngle > 1.0f)
+	{
+		HourAngle = 0.0f;
+		return -1;
+	}
+	if (CosHourAngle < -1.0f)
+	{
+		HourAngle = 180.0f;
+		return 1;
+	}
+	HourAngle = FMath::RadiansToDegrees(FMath::Acos(CosHourAngle));
+	return 0;
+}
+
+/**
+ * 太阳时角转换为当日累计秒数，与CalculateSunPosition中的时角定义互逆
+ * @param HourAngle 时角（度）
+ * @param Longitude 经度（度），东经为正
+ * @return 当日累计秒数（0~86400）
+ */
+inline float ConvertSunHourAngleToTimeStampOfEarthDay(const float& HourAngle, const float& Longitude)
+{
+	// H = 15 * (LocalHour + (Longitude - 120) / 15 - 12)
+	float LocalHour = (HourAngle - Longitude + STANDARD_MERIDIAN) / DEG_TO_HOUR + 12.0f;
+	return FMath::Fmod(FMath::Fmod(LocalHour, 24.0f) + 24.0f, 24.0f) * SECONDS_PER_HOUR;
+}
+
+/**
+ * 计算指定时间的月球赤道坐标（赤经、赤纬），只随日期缓慢变化，与观测点无关
+ * @param TimeStampOfEarthYear 当年累计秒数（0~31536000）
+ * @param ra [输出] 赤经（度），范围0~360
+ * @param dec [输出] 赤纬（度）
+ */
+inline void CalculateMoonEquatorialCoordinate(
+    const float& TimeStampOfEarthYear,
+    float& ra,
+    float& dec)
+{
+	double totalSecondsSinceJ2000Epoch = TimeStampOfEarthYear;
+    
+	// 将总秒数转换为从J2000起算的天数
+	double daysSinceJ2000Epoch = totalSecondsSinceJ2000Epoch / SECONDS_PER_DAY_EARTH;
+    
+	// 计算当前时刻的儒略日
+	// 因为J2000的儒略日是2451545.0（对应当年中午12点），而我们的时间原点是当天0点，所以有0.5天的偏移
+	double currentJulianDay = J2000_JD - 0.5 + daysSinceJ2000Epoch;
+    
+	// ===== 2. 计算儒略世纪数T =====
+	// T 是从J2000（2451545.0 JD）起算的儒略世纪数
+	double T = (currentJulianDay - J2000_JD) / DAYS_PER_CENTURY;
+	
+    // ===== 2. 计算月球轨道参数（简化平根数） =====
+    // 月球平黄经（度）
+    float meanLongitude = 218.3164477f + 481267.88123421f * T;
+    meanLongitude = FMath::Fmod(meanLongitude, 360.0f);
+    if (meanLongitude < 0) meanLongitude += 360.0f;
+	
+    // 月球平近点角（度）
+    float meanAnomaly = 134.9633964f + 477198.8675055f * T;
+    meanAnomaly = FMath::Fmod(meanAnomaly, 360.0f);
+    if (meanAnomaly < 0) meanAnomaly += 360.0f;
+	
+    // 升交点平黄经（度）
+    float ascendingNode = 125.0445550f - 1934.1361849f * T;
+    ascendingNode = FMath::Fmod(ascendingNode, 360.0f);
+    if (ascendingNode < 0) ascendingNode += 360.0f;
+	
+    // ===== 3. 计算月球黄经和黄纬（简化版） =====
+    // 只考虑最大的摄动项（约6.3度振幅）
+    float longitude = meanLongitude + 6.289f * FMath::Sin(FMath::DegreesToRadians(meanAnomaly));
+    longitude = FMath::Fmod(longitude, 360.0f);
+    if (longitude < 0) longitude += 360.0f;
+	
+    // 黄纬（主要受交点影响，约5.1度振幅）
+    float latitude = 5.128f * FMath::Sin(FMath::DegreesToRadians(ascendingNode));
+    latitude = FMath::Fmod(latitude, 360.0f);
+    if (latitude < 0) latitude += 360.0f;
+	
+    // ===== 4. 坐标转换：黄道坐标 -> 赤道坐标 =====
+    float eclipticObliquity = FMath::DegreesToRadians(OBLIQUITY);
+	
+	float Rad_longitude = FMath::DegreesToRadians(longitude);
+	float Rad_latitude = FMath::DegreesToRadians(latitude);
+	
+    float sinLongitude = FMath::Sin(Rad_longitude);
+    float cosLongitude = FMath::Cos(Rad_longitude);
+    float sinLatitude = FMath::Sin(Rad_latitude);
+    float cosLatitude = FMath::Cos(Rad_latitude);
+    float sinObliquity = FMath::Sin(eclipticObliquity);
+    float cosObliquity = FMath::Cos(eclipticObliquity);
+	
+    // 赤经计算
+    ra = FMath::RadiansToDegrees(
+    	FMath::Atan2(sinLongitude * cosObliquity - FMath::Tan(Rad_latitude) * sinObliquity, cosLongitude));
+    ra = FMath::Fmod(ra + 360.0f, 360.0f);
+	
+    // 赤纬计算
+    dec = FMath::RadiansToDegrees(
+    	FMath::Asin(
+			sinLatitude * cosObliquity + cosLatitude * sinObliquity * sinLongitude
+    ));
+}
+
+/**
+ * 计算指定地理位置和时间的月球位置（高度角、方位角）- 简化版
+ * @param Latitude 纬度（度），北纬为正
+ * @param Longitude 经度（度），东经为正
+ * @param TimeStampOfEarthDay 当日累计秒数（0~86400）
+ * @param TimeStampOfEarthYear 当年累计秒数（0~31536000）
+ * @param MoonElevation [输出] 月球高度角（度）
+ * @param MoonAzimuth [输出] 月球方位角（度），从正北顺时针测量
+ */
+template<typename MathPolicy = FAetherPreciseMath>
+inline void CalculateMoonPosition(
+    const float& Latitude,
+    const float& Longitude,
+    const float& TimeStampOfEarthDay,
+    const float& TimeStampOfEarthYear,
+    float& MoonElevation,
+    float& MoonAzimuth)
+{
+	// 自J2000起算的天数（时间原点为当天0点，相对J2000中午有0.5天偏移）
+	float daysSince2000 = TimeStampOfEarthYear / SECONDS_PER_DAY_EARTH - 0.5f;
+	
+	float ra = 0.0f;
+	float dec = 0.0f;
+	CalculateMoonEquatorialCoordinate(TimeStampOfEarthYear, ra, dec);
+	
+    // ===== 5. 计算时角 =====
+    // 计算格林尼治恒星时（简化公式）
+    float greenwichSiderealTime = 280.46061837f + 360.98564736629f * daysSince2000;
+    greenwichSiderealTime = MathPolicy::Fmod(greenwichSiderealTime, 360.0f);
+    if (greenwichSiderealTime < 0) greenwichSiderealTime += 360.0f;
+	
+    // 本地恒星时
+    float localSiderealTime = greenwichSiderealTime + Longitude;
+    localSiderealTime = MathPolicy::Fmod(localSiderealTime, 360.0f);
+    if (localSiderealTime < 0) localSiderealTime += 360.0f;
+	
+    // 月球时角
+    float hourAngle = localSiderealTime - ra;
+    hourAngle = MathPolicy::Fmod(hourAngle + 360.0f, 360.0f);
+    if (hourAngle > 180.0f) hourAngle -= 360.0f;
+	
+    // ===== 6. 计算月球高度角和方位角 =====
+    float latRad = FMath::DegreesToRadians(Latitude);
+    float decRad = FMath::DegreesToRadians(dec);
+    float haRad = FMath::DegreesToRadians(hourAngle);
+	
+    // 高度角计算
+    float sinAlt = MathPolicy::Sin(latRad) * MathPolicy::Sin(decRad) + 
+                  MathPolicy::Cos(latRad) * MathPolicy::Cos(decRad) * MathPolicy::Cos(haRad);
+    sinAlt = FMath::Clamp(sinAlt, -1.0f, 1.0f);
+    MoonElevation = FMath::RadiansToDegrees(MathPolicy::Asin(sinAlt));
+	
+    // 方位角计算（使用atan2确保正确的象限）
+    float sinAz = -MathPolicy::Cos(decRad) * MathPolicy::Sin(haRad);
+    float cosAz = MathPolicy::Sin(decRad) * MathPolicy::Cos(latRad) - 
+                 MathPolicy::Cos(decRad) * MathPolicy::Sin(latRad) * MathPolicy::Cos(haRad);
+    
+    MoonAzimuth = FMath::RadiansToDegrees(MathPolicy::Atan2(sinAz, cosAz));
+    MoonAzimuth = MathPolicy::Fmod(MoonAzimuth + 360.0f, 360.0f);
+}
+
+/**
+ * 计算月龄角（月球相对太阳的距角，按盈亏展开到0~360度），0=新月，180=满月
+ * @param TimeStampOfEarthYear 当年累计秒数（0~31536000）
+ * @return 月龄角（度）
+ */
+inline float CalculateMoonAgeAngle(const float& TimeStampOfEarthYear)
+{
+	// 太阳黄经与赤纬公式保持一致：δ = ε·sin(λ)，λ = 2π(284 + N) / 365
+	float DateOfYear = FMath::Fmod(TimeStampOfEarthYear / SECONDS_PER_DAY_EARTH, DAYS_PER_YEAR_EARTH);
+	float SunLongitude = 2 * PI * (284.0f + DateOfYear) / DAYS_PER_YEAR_EARTH;
+	float SunDeclination = CalculateSolarDeclination(DateOfYear);
+	float SunRightAscension = FMath::Atan2(FMath::Cos(FMath::DegreesToRadians(OBLIQUITY)) * FMath::Sin(SunLongitude), FMath::Cos(SunLongitude));
+	
+	float ra = 0.0f;
+	float dec = 0.0f;
+	CalculateMoonEquatorialCoordinate(TimeStampOfEarthYear, ra, dec);
+	float MoonRightAscension = FMath::DegreesToRadians(ra);
+	float MoonDeclination = FMath::DegreesToRadians(dec);
+	
+	// 距角：cos(ψ) = sin(δs)sin(δm) + cos(δs)cos(δm)cos(αm - αs)
+	float DeltaRightAscension = MoonRightAscension - SunRightAscension;
+	float CosElongation = FMath::Sin(SunDeclination) * FMath::Sin(MoonDeclination)
+						+ FMath::Cos(SunDeclination) * FMath::Cos(MoonDeclination) * FMath::Cos(DeltaRightAscension);
+	float Elongation = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(CosElongation, -1.0f, 1.0f)));
+	
+	// 月球在太阳以东为上弦（盈），以西为下弦（亏）
+	return FMath::Sin(DeltaRightAscension) >= 0.0f ? Elongation : 360.0f - Elongation;
+}
+
+/**
+ * 由月龄角计算月相与月光照度（忽略日月距离比）
+ * @param AgeAngle 月龄角（度），0~360
+ * @param PhaseAngle [输出] 相位角（度），0=满月，180=新月
+ * @param IlluminatedFraction [输出] 被照亮比例（0~1）
+ * @param Illuminance [输出] 月球位于天顶时的地面照度（lux），不含大气消光
+ */
+inline void CalculateMoonIllumination(
+	const float& AgeAngle,
+	float& PhaseAngle,
+	float& IlluminatedFraction,
+	float& Illuminance)
+{
+	float Elongation = AgeAngle <= 180.0f ? AgeAngle : 360.0f - AgeAngle;
+	PhaseAngle = 180.0f - Elongation;
+	IlluminatedFraction = 0.5f * (1.0f + FMath::Cos(FMath::DegreesToRadians(PhaseAngle)));
+	
+	// 月球视星等：m = -12.73 + 0.026|i| + 4e-9·i^4，照度 E = 10^(-0.4(m + 14.18))
+	float Magnitude = -12.73f + 0.026f * PhaseAngle + 4.0e-9f * FMath::Square(FMath::Square(PhaseAngle));
+	Illuminance = FMath::Pow(10.0f, -0.4f * (Magnitude + 14.18f));
+}
+
+/**
+ * 由赤纬与时角计算地平坐标（4路SIMD）
+ * @param SinLat, CosLat 纬度的正弦/余弦
+ * @param SinDec, CosDec 赤纬的正弦/余弦
+ * @param HourAngleRad 时角（弧度）
+ * @param Elevation [输出] 高度角（度）
+ * @param Azimuth [输出] 方位角（度），从正北顺时针测量，范围0~360
+ */
+template<typename MathPolicy = FAetherPreciseMath>
+FORCEINLINE void CalculateHorizontalCoordinate4(
+	const VectorRegister4Float& SinLat,
+	const VectorRegister4Float& CosLat,
+	const VectorRegister4Float& SinDec,
+	const VectorRegister4Float& CosDec,
+	const VectorRegister4Float& HourAngleRad,
+	VectorRegister4Float& Elevation,
+	VectorRegister4Float& Azimuth)
+{
+	const VectorRegister4Float RadToDeg = VectorSetFloat1(180.0f / PI);
+
+	VectorRegister4Float SinH, CosH;
+	MathPolicy::VectorSinCos(&SinH, &CosH, &HourAngleRad);
+
+	// sin(α) = sin(φ)sin(δ) + cos(φ)cos(δ)cos(H)
+	const VectorRegister4Float CosDecCosH = VectorMultiply(CosDec, CosH);
+	VectorRegister4Float SinElevation = VectorMultiplyAdd(CosLat, CosDecCosH, VectorMultiply(SinLat, SinDec));
+	SinElevation = VectorMin(VectorMax(SinElevation, GlobalVectorConstants::FloatMinusOne), GlobalVectorConstants::FloatOne);
+	Elevation = VectorMultiply(MathPolicy::VectorASin(SinElevation), RadToDeg);
+
+	// tan(Az) = -cos(δ)sin(H) / [sin(δ)cos(φ) - cos(δ)sin(φ)cos(H)]
+	const VectorRegister4Float SinAzimuth = VectorNegate(VectorMultiply(CosDec, SinH));
+	const VectorRegister4Float CosAzimuth = VectorSubtract(VectorMultiply(SinDec, CosLat), VectorMultiply(SinLat, CosDecCosH));
+	Azimuth = VectorMultiply(MathPolicy::VectorATan2(SinAzimuth, CosAzimuth), RadToDeg);
+	Azimuth = VectorSelect(VectorCompareLT(Azimuth, GlobalVectorConstants::FloatZero), VectorAdd(Azimuth, VectorSetFloat1(360.0f)), Azimuth);
+}
+
+/**
+ * 计算太阳位置（4路SIMD），与CalculateSunPosition逐项对应
+ */
+template<typename MathPolicy = FAetherPreciseMath>
+FORCEINLINE void CalculateSunPosition4(
+	const VectorRegister4Float& Latitude,
+	const VectorRegister4Float& Longitude,
+	const VectorRegister4Float& TimeStampOfEarthDay,
+	const VectorRegister4Float& TimeStampOfEarthYear,
+	VectorRegister4Float& SunElevation,
+	VectorRegister4Float& SunAzimuth,
+	int32 PolarCondition[4])
+{
+	const VectorRegister4Float DegToRad = VectorSetFloat1(PI / 180.0f);
+
+	// 年序日
+	const VectorRegister4Float DateOfYear = VectorMod(VectorMultiply(TimeStampOfEarthYear, VectorSetFloat1(1.0f / SECONDS_PER_DAY_EARTH)), VectorSetFloat1(DAYS_PER_YEAR_EARTH));
+
+	// 太阳赤纬角（δ）
+	const VectorRegister4Float DeclinationPhase = VectorMultiply(VectorAdd(DateOfYear, VectorSetFloat1(284.0f)), VectorSetFloat1(2.0f * PI / DAYS_PER_YEAR_EARTH));
+	const VectorRegister4Float SolarDeclination = VectorMultiply(MathPolicy::VectorSin(DeclinationPhase), VectorSetFloat1(FMath::DegreesToRadians(OBLIQUITY)));
+
+	// 时角（H）：15 * (LocalHour + (Longitude - 120) / 15 - 12) = 15 * LocalHour + Longitude - 300
+	const VectorRegister4Float HourAngleDeg = VectorMultiplyAdd(TimeStampOfEarthDay, VectorSetFloat1(DEG_TO_HOUR / SECONDS_PER_HOUR), VectorSubtract(Longitude, VectorSetFloat1(STANDARD_MERIDIAN + DEG_TO_HOUR * 12.0f)));
+	const VectorRegister4Float HourAngleRad = VectorMultiply(HourAngleDeg, DegToRad);
+
+	const VectorRegister4Float LatRad = VectorMultiply(Latitude, DegToRad);
+	VectorRegister4Float SinLat, CosLat, SinDec, CosDec;
+	MathPolicy::VectorSinCos(&SinLat, &CosLat, &LatRad);
+	MathPolicy::VectorSinCos(&SinDec, &CosDec, &SolarDeclination);
+
+	CalculateHorizontalCoordinate4<MathPolicy>(SinLat, CosLat, SinDec, CosDec, HourAngleRad, SunElevation, SunAzimuth);
+
+	// 极昼/极夜检测
+	const VectorRegister4Float CriticalAngleCos = VectorDivide(VectorNegate(VectorMultiply(SinLat, SinDec)), VectorMultiply(CosLat, CosDec));
+	const VectorRegister4Float PolarNightMask = VectorCompareGT(CriticalAngleCos, GlobalVectorConstants::FloatOne);
+	const VectorRegister4Float PolarDayMask = VectorCompareLT(CriticalAngleCos, GlobalVectorConstants::FloatMinusOne);
+	SunElevation = VectorSelect(PolarNightMask, VectorSetFloat1(-90.0f), SunElevation);
+	SunElevation = VectorSelect(PolarDayMask, VectorSetFloat1(90.0f), SunElevation);
+
+	const int32 PolarNightBits = VectorMaskBits(PolarNightMask);
+	const int32 PolarDayBits = VectorMaskBits(PolarDayMask);
+	for (int32 Lane = 0; Lane < 4; Lane++)
+	{
+		PolarCondition[Lane] = (PolarDayBits >> Lane & 1) - (PolarNightBits >> Lane & 1);
+	}
+}
+
+/**
+ * 计算月球位置（4路SIMD），与CalculateMoonPosition逐项对应
+ */
+template<typename MathPolicy = FAetherPreciseMath>
+FORCEINLINE void CalculateMoonPosition4(
+	const VectorRegister4Float& Latitude,
+	const VectorRegister4Float& Longitude,
+	const VectorRegister4Float& TimeStampOfEarthDay,
+	const VectorRegister4Float& TimeStampOfEarthYear,
+	VectorRegister4Float& MoonElevation,
+	VectorRegister4Float& MoonAzimuth)
+{
+	const VectorRegister4Float DegToRad = VectorSetFloat1(PI / 180.0f);
+
+	// 自J2000起算的天数（时间原点为当天0点，相对J2000中午有0.5天偏移）与儒略世纪数
+	const VectorRegister4Float DaysSince2000 = VectorMultiplyAdd(TimeStampOfEarthYear, VectorSetFloat1(1.0f / SECONDS_PER_DAY_EARTH), VectorSetFloat1(-0.5f));
+	const VectorRegister4Float T = VectorMultiply(DaysSince2000, VectorSetFloat1(1.0f / DAYS_PER_CENTURY));
+
+	// 月球平黄经、平近点角、升交点平黄经（度），三角函数自带周期，无需取模
+	const VectorRegister4Float MeanLongitude = VectorMultiplyAdd(T, VectorSetFloat1(481267.88123421f), VectorSetFloat1(218.3164477f));
+	const VectorRegister4Float MeanAnomaly = VectorMultiplyAdd(T, VectorSetFloat1(477198.8675055f), VectorSetFloat1(134.9633964f));
+	const VectorRegister4Float AscendingNode = VectorMultiplyAdd(T, VectorSetFloat1(-1934.1361849f), VectorSetFloat1(125.0445550f));
+
+	// 黄经、黄纬（弧度）
+	const VectorRegister4Float EclipticLongitude = VectorMultiply(VectorMultiplyAdd(MathPolicy::VectorSin(VectorMultiply(MeanAnomaly, DegToRad)), VectorSetFloat1(6.289f), MeanLongitude), DegToRad);
+	const VectorRegister4Float EclipticLatitude = VectorMultiply(VectorMultiply(MathPolicy::VectorSin(VectorMultiply(AscendingNode, DegToRad)), VectorSetFloat1(5.128f)), DegToRad);
+
+	VectorRegister4Float SinLongitude, CosLongitude, SinLatitude, CosLatitude;
+	MathPolicy::VectorSinCos(&SinLongitude, &CosLongitude, &EclipticLongitude);
+	MathPolicy::VectorSinCos(&SinLatitude, &CosLatitude, &EclipticLatitude);
+	const VectorRegister4Float SinObliquity = VectorSetFloat1(FMath::Sin(FMath::DegreesToRadians(OBLIQUITY)));
+	const VectorRegister4Float CosObliquity = VectorSetFloat1(FMath::Cos(FMath::DegreesToRadians(OBLIQUITY)));
+
+	// 黄道坐标 -> 赤道坐标：赤经（弧度）、赤纬正弦
+	const VectorRegister4Float TanLatitude = VectorDivide(SinLatitude, CosLatitude);
+	const VectorRegister4Float RightAscension = MathPolicy::VectorATan2(VectorSubtract(VectorMultiply(SinLongitude, CosObliquity), VectorMultiply(TanLatitude, SinObliquity)), CosLongitude);
+	VectorRegister4Float SinDec = VectorMultiplyAdd(VectorMultiply(CosLatitude, SinObliquity), SinLongitude, VectorMultiply(SinLatitude, CosObliquity));
+	SinDec = VectorMin(VectorMax(SinDec, GlobalVectorConstants::FloatMinusOne), GlobalVectorConstants::FloatOne);
+	const VectorRegister4Float CosDec = VectorSqrt(VectorMax(VectorNegateMultiplyAdd(SinDec, SinDec, GlobalVectorConstants::FloatOne), GlobalVectorConstants::FloatZero));
+
+	// 格林尼治恒星时：360.98564736629 * d ≡ 360 * frac(d) + 0.98564736629 * d (mod 360)，避免大数损失精度
+	const VectorRegister4Float DayFraction = VectorSubtract(DaysSince2000, VectorFloor(DaysSince2000));
+	const VectorRegister4Float GreenwichSiderealTime = VectorAdd(VectorMultiplyAdd(DayFraction, VectorSetFloat1(360.0f), VectorMultiply(DaysSince2000, VectorSetFloat1(0.98564736629f))), VectorSetFloat1(280.46061837f));
+
+	// 月球时角 = 本地恒星时 - 赤经
+	const VectorRegister4Float HourAngleRad = VectorSubtract(VectorMultiply(VectorAdd(GreenwichSiderealTime, Longitude), DegToRad), RightAscension);
+
+	const VectorRegister4Float LatRad = VectorMultiply(Latitude, DegToRad);
+	VectorRegister4Float SinLat, CosLat;
+	MathPolicy::VectorSinCos(&SinLat, &CosLat, &LatRad);
+
+	CalculateHorizontalCoordinate4<MathPolicy>(SinLat, CosLat, SinDec, CosDec, HourAngleRad, MoonElevation, MoonAzimuth);
+}
+
+/**
+ * 批量计算太阳位置（SoA布局，每次处理4个点，尾部不足4个时补齐）
+ * @param Num 点数，所有数组长度均不小于Num
+ * @param PolarCondition [输出] 可为空
+ */
+template<typename MathPolicy = FAetherPreciseMath>
+inline void CalculateSunPositionBatch(
+	const float* RESTRICT Latitude,
+	const float* RESTRICT Longitude,
+	const float* RESTRICT TimeStampOfEarthDay,
+	const float* RESTRICT TimeStampOfEarthYear,
+	float* RESTRICT SunElevation,
+	float* RESTRICT SunAzimuth,
+	int32* RESTRICT PolarCondition,
+	const int32 Num)
+{
+	int32 Index = 0;
+	int32 LanePolarCondition[4];
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		VectorRegister4Float Elevation, Azimuth;
+		CalculateSunPosition4<MathPolicy>(
+			VectorLoad(Latitude + Index),
+			VectorLoad(Longitude + Index),
+			VectorLoad(TimeStampOfEarthDay + Index),
+			VectorLoad(TimeStampOfEarthYear + Index),
+			Elevation,
+			Azimuth,
+			LanePolarCondition);
+		VectorStore(Elevation, SunElevation + Index);
+		VectorStore(Azimuth, SunAzimuth + Index);
+		if (PolarCondition)
+		{
+			FMemory::Memcpy(PolarCondition + Index, LanePolarCondition, sizeof(LanePolarCondition));
+		}
+	}
+
+	const int32 Remain = Num - Index;
+	if (Remain > 0)
+	{
+		float Lanes[4][4] = {};
+		for (int32 Lane = 0; Lane < Remain; Lane++)
+		{
+			Lanes[0][Lane] = Latitude[Index + Lane];
+			Lanes[1][Lane] = Longitude[Index + Lane];
+			Lanes[2][Lane] = TimeStampOfEarthDay[Index + Lane];
+			Lanes[3][Lane] = TimeStampOfEarthYear[Index + Lane];
+		}
+		VectorRegister4Float Elevation, Azimuth;
+		CalculateSunPosition4<MathPolicy>(VectorLoad(Lanes[0]), VectorLoad(Lanes[1]), VectorLoad(Lanes[2]), VectorLoad(Lanes[3]), Elevation, Azimuth, LanePolarCondition);
+		VectorStore(Elevation, Lanes[0]);
+		VectorStore(Azimuth, Lanes[1]);
+		for (int32 Lane = 0; Lane < Remain; Lane++)
+		{
+			SunElevation[Index + Lane] = Lanes[0][Lane];
+			SunAzimuth[Index + Lane] = Lanes[1][Lane];
+			if (PolarCondition)
+			{
+				PolarCondition[Index + Lane] = LanePolarCondition[Lane];
+			}
+		}
+	}
+}
+
+/**
+ * 批量计算月球位置（SoA布局，每次处理4个点，尾部不足4个时补齐）
+ * @param Num 点数，所有数组长度均不小于Num
+ */
+template<typename MathPolicy = FAetherPreciseMath>
+inline void CalculateMoonPositionBatch(
+	const float* RESTRICT Latitude,
+	const float* RESTRICT Longitude,
+	const float* RESTRICT TimeStampOfEarthDay,
+	const float* RESTRICT TimeStampOfEarthYear,
+	float* RESTRICT MoonElevation,
+	float* RESTRICT MoonAzimuth,
+	const int32 Num)
+{
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		VectorRegister4Float Elevation, Azimuth;
+		CalculateMoonPosition4<MathPolicy>(
+			VectorLoad(Latitude + Index),
+			VectorLoad(Longitude + Index),
+			VectorLoad(TimeStampOfEarthDay + Index),
+			VectorLoad(TimeStampOfEarthYear + Index),
+			Elevation,
+			Azimuth);
+		VectorStore(Elevation, MoonElevation + Index);
+		VectorStore(Azimuth, MoonAzimuth + Index);
+	}
+
+	const int32 Remain = Num - Index;
+	if (Remain > 0)
+	{
+		float Lanes[4][4] = {};
+		for (int32 Lane = 0; Lane < Remain; Lane++)
+		{
+			Lanes[0][Lane] = Latitude[Index + Lane];
+			Lanes[1][Lane] = Longitude[Index + Lane];
+			Lanes[2][Lane] = TimeStampOfEarthDay[Index + Lane];
+			Lanes[3][Lane] = TimeStampOfEarthYear[Index + Lane];
+		}
+		VectorRegister4Float Elevation, Azimuth;
+		CalculateMoonPosition4<MathPolicy>(VectorLoad(Lanes[0]), VectorLoad(Lanes[1]), VectorLoad(Lanes[2]), VectorLoad(Lanes[3]), Elevation, Azimuth);
+		VectorStore(Elevation, Lanes[0]);
+		VectorStore(Azimuth, Lanes[1]);
+		for (int32 Lane = 0; Lane < Remain; Lane++)
+		{
+			MoonElevation[Index + Lane] = Lanes[0][Lane];
+			MoonAzimuth[Index + Lane] = Lanes[1][Lane];
+		}
+	}
+}
+
+/* Vector Pivot: Local Position, Vector Point at: Planet. */
+inline FRotator ConvertPlanetRotation(const float& ElevationDegree, const float& AzimuthDegree)
+{
+	FRotator Rotator = FRotator::ZeroRotator;
+	Rotator.Pitch = ElevationDegree;
+	Rotator.Yaw = AzimuthDegree;
+	return Rotator;
+}
+
+/* Vector Pivot: Local Position, Vector Point at: Planet. */
+inline FVector ConvertPlanetDirection(const float& ElevationDegree, const float& AzimuthDegree)
+{
+	return ConvertPlanetRotation(ElevationDegree, AzimuthDegree).Vector();
+}
+
+/* Vector Pivot: Planet, Vector Point at: Local Position. */
+inline FVector ConvertPlanetLightDirection(const float& ElevationDegree, const float& AzimuthDegree)
+{
+	return -ConvertPlanetDirection(ElevationDegree, AzimuthDegree);
+}
\ No newline at end of file
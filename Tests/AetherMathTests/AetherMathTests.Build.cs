@@ -0,0 +1,20 @@
+//
+// Aether: Real-Time Sky & Environment & Weather simulation plugin.
+//		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+//
+
+using UnrealBuildTool;
+
+public class AetherMathTests : TestModuleRules
+{
+	public AetherMathTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"AetherMath",
+				"Core",
+			}
+			);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+//
+// Aether: Real-Time Sky & Environment & Weather simulation plugin.
+//		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+//
+
+using UnrealBuildTool;
+
+// Catch2 low-level tests of AetherMath, no editor boot. Build the AetherMathTests target and run the executable, e.g.
+// AetherMathTests.exe "[Aether]"
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class AetherMathTestsTarget : TestTargetRules
+{
+	public AetherMathTestsTarget(TargetInfo Target) : base(Target)
+	{
+		// AetherMath depends on Core only.
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+ * Aether: Real-Time Sky & Environment & Weather simulation plugin.
+ *		Copyright Technical Artist - Jiahao.Chan, Individual. All Rights Reserved.
+ */
+
+#include "CoreMinimal.h"
+#include "TestHarness.h"
+
+#include "AetherEphemerisSamples.h"
+#include "AetherMathVerification.h"
+
+static void CheckAll(const FAetherMathVerification& Verification)
+{
+	REQUIRE(Verification.GetChecks().Num() > 0);
+	for (const FAetherMathCheck& Check : Verification.GetChecks())
+	{
+		INFO(TCHAR_TO_UTF8(*FString::Printf(TEXT("%s: %.4f (expected %.4f, tolerance %.4f)"), Check.Name, Check.Value, Check.Expected, Check.Tolerance)));
+		CHECK(Check.IsPassed());
+	}
+}
+
+TEST_CASE("Aether::Math::Almanac", "[Aether][Math]")
+{
+	FAetherMathVerification Verification;
+	Verification.VerifyAlmanac();
+	CheckAll(Verification);
+}
+
+TEST_CASE("Aether::Math::Consistency", "[Aether][Math]")
+{
+	FAetherMathVerification Verification;
+	Verification.VerifyConsistency();
+	CheckAll(Verification);
+}
+
+TEST_CASE("Aether::Math::Kepler", "[Aether][Math]")
+{
+	FAetherMathVerification Verification;
+	Verification.VerifyKepler();
+	CheckAll(Verification);
+}
+
+TEST_CASE("Aether::Math::Clock", "[Aether][Math]")
+{
+	FAetherMathVerification Verification;
+	Verification.VerifyClock();
+	CheckAll(Verification);
+}
+
+TEST_CASE("Aether::Math::EphemerisSamples", "[Aether][Math]")
+{
+	SECTION("Random points repeat with the seed")
+	{
+		FAetherEphemerisSamples A, B;
+		A.InitRandom(64);
+		B.InitRandom(64);
+		REQUIRE(A.Num() == 64);
+		CHECK(A.Latitude == B.Latitude);
+		CHECK(A.Longitude == B.Longitude);
+		CHECK(A.TimeStampOfEarthDay == B.TimeStampOfEarthDay);
+		CHECK(A.TimeStampOfEarthYear == B.TimeStampOfEarthYear);
+	}
+	
+	SECTION("Sweep takes the center of each step")
+	{
+		FAetherEphemerisSamples Samples;
+		Samples.InitSweep(2, 3, 4, 5);
+		REQUIRE(Samples.Num() == 2 * 3 * 4 * 5);
+		CHECK(Samples.Latitude[0] == -44.5f);
+		CHECK(Samples.Latitude.Last() == 44.5f);
+		CHECK(FMath::IsNearlyEqual(Samples.Longitude[0], -120.0f, 1.0e-4f));
+		CHECK(Samples.TimeStampOfEarthDay[0] == 10800.0f);
+	}
+}
\ No newline at end of file